@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    ChainSettings.h
+
+    Plain description of the filter settings shared by the processor, the
+    parameter cache and the coefficient design helpers.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+enum Slope
+{
+    Slope_12,
+    Slope_24,
+    Slope_36,
+    Slope_48
+};
+
+//create a data structure to extract parameters from audio processor value tree state
+struct ChainSettings
+{
+    float peakFreq{ 0 }, peakGainInDecibels{ 0 }, peakQuality{ 1.f };
+    float lowCutFreq{ 0 }, highCutFreq{ 0 };
+    Slope lowCutSlope{Slope::Slope_12}, highCutSlope{ Slope::Slope_12};
+};
+
+//exact comparison, for telling whether a design was made from these settings
+inline bool operator== (const ChainSettings& a, const ChainSettings& b) noexcept
+{
+    return a.peakFreq == b.peakFreq && a.peakGainInDecibels == b.peakGainInDecibels && a.peakQuality == b.peakQuality
+        && a.lowCutFreq == b.lowCutFreq && a.highCutFreq == b.highCutFreq
+        && a.lowCutSlope == b.lowCutSlope && a.highCutSlope == b.highCutSlope;
+}
+
+inline bool operator!= (const ChainSettings& a, const ChainSettings& b) noexcept { return ! (a == b); }
+
+
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
+
+//the peak band's gain following a level detector, see DynamicBand
+struct DynamicSettings
+{
+    bool isEnabled{ false };
+    bool useSidechain{ false };                 //listen to the sidechain bus instead of the main input, when the host connects one
+    float thresholdInDecibels{ -24.f };
+    float ratio{ 2.f };
+    float rangeInDecibels{ -6.f };              //most the gain can move, negative cuts the band when the level goes over
+    float attackMs{ 10.f }, releaseMs{ 150.f };
+};
+
+//the extra bands of the parametric engine can go up to this many, the processor is told how many to run in prepareToPlay
+constexpr int maxParametricBands = 24;
+
+//choice index of each "Band n Type" parameter
+enum class BandType
+{
+    off,
+    peak,
+    lowShelf,
+    highShelf,
+    notch
+};
+
+struct BandSettings
+{
+    BandType type{ BandType::off };
+    float frequency{ 1000.f }, gainInDecibels{ 0 }, quality{ 1.f };
+};
+
+//"Band 1 Freq" and so on, the band index starts at 0 but the names start at 1
+inline juce::String getBandParameterID(int band, const juce::String& name)
+{
+    return "Band " + juce::String(band + 1) + " " + name;
+}
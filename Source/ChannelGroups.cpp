@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    ChannelGroups.cpp
+
+  ==============================================================================
+*/
+
+#include "ChannelGroups.h"
+
+ChannelGroup getChannelGroup(juce::AudioChannelSet::ChannelType type)
+{
+    using Set = juce::AudioChannelSet;
+
+    switch (type)
+    {
+        case Set::centre:
+            return Group_Centre;
+
+        case Set::LFE:
+        case Set::LFE2:
+            return Group_LFE;
+
+        case Set::leftSurround:
+        case Set::rightSurround:
+        case Set::centreSurround:
+        case Set::leftSurroundSide:
+        case Set::rightSurroundSide:
+        case Set::leftSurroundRear:
+        case Set::rightSurroundRear:
+            return Group_Surround;
+
+        case Set::topMiddle:
+        case Set::topFrontLeft:
+        case Set::topFrontCentre:
+        case Set::topFrontRight:
+        case Set::topRearLeft:
+        case Set::topRearCentre:
+        case Set::topRearRight:
+        case Set::topSideLeft:
+        case Set::topSideRight:
+            return Group_Height;
+
+        //left/right, wides, ambisonic and discrete channels
+        default:
+            return Group_Front;
+    }
+}
+
+std::vector<ChannelGroup> getChannelGroups(const juce::AudioChannelSet& layout, int numChannels)
+{
+    std::vector<ChannelGroup> groups((size_t) numChannels, Group_Front);
+
+    for (int ch = 0; ch < juce::jmin(numChannels, layout.size()); ++ch)
+        groups[(size_t) ch] = getChannelGroup(layout.getTypeOfChannel(ch));
+
+    return groups;
+}
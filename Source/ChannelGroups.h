@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+    ChannelGroups.h
+
+    Splits the channels of a surround bus into groups that can either follow
+    the plugin parameters together (linked) or be given settings of their own.
+
+    Ambisonic and discrete layouts put every channel in Group_Front, so their
+    channels always get identical filters and the sound field isn't skewed.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+enum ChannelGroup
+{
+    Group_Front,
+    Group_Centre,
+    Group_LFE,
+    Group_Surround,
+    Group_Height,
+
+    numChannelGroups
+};
+
+ChannelGroup getChannelGroup(juce::AudioChannelSet::ChannelType type);
+
+//group of every channel in a layout, in channel order
+std::vector<ChannelGroup> getChannelGroups(const juce::AudioChannelSet& layout, int numChannels);
@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+    CoefficientCache.cpp
+
+  ==============================================================================
+*/
+
+#include "CoefficientCache.h"
+
+namespace
+{
+    template <typename Type>
+    juce::uint64 getBits(Type value) noexcept
+    {
+        static_assert(sizeof(Type) <= sizeof(juce::uint64));
+
+        juce::uint64 bits = 0;
+        std::memcpy(&bits, &value, sizeof(value));
+        return bits;
+    }
+
+    //splitmix64 finaliser, the frequency bits alone cluster badly
+    juce::uint64 mix(juce::uint64 value) noexcept
+    {
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+}
+
+CoefficientCache::Key CoefficientCache::makeKey(Band band, double sampleRate, float frequency, float quality,
+                                                float gainInDecibels, Slope slope) noexcept
+{
+    jassert(sampleRate > 0);
+
+    return { getBits(sampleRate),
+             getBits(frequency) | (getBits(quality) << 32),
+             getBits(gainInDecibels) | ((juce::uint64) band << 32) | ((juce::uint64) slope << 40) };
+}
+
+size_t CoefficientCache::getFirstSlot(const Key& key) noexcept
+{
+    constexpr size_t numBuckets = numSlots / slotsPerBucket;
+
+    return (size_t) (mix(key[0] ^ mix(key[1] ^ mix(key[2]))) % numBuckets) * slotsPerBucket;
+}
+
+CutCoefficients CoefficientCache::getLowCutCoefficients(const ChainSettings& chainSettings, double sampleRate) noexcept
+{
+    auto key = makeKey(Band::lowCut, sampleRate, chainSettings.lowCutFreq, 0.f, 0.f, chainSettings.lowCutSlope);
+
+    return getOrDesign(key, getNumValues(Band::lowCut), [&] { return makeLowCutCoefficients(chainSettings, sampleRate); });
+}
+
+CutCoefficients CoefficientCache::getHighCutCoefficients(const ChainSettings& chainSettings, double sampleRate) noexcept
+{
+    auto key = makeKey(Band::highCut, sampleRate, chainSettings.highCutFreq, 0.f, 0.f, chainSettings.highCutSlope);
+
+    return getOrDesign(key, getNumValues(Band::highCut), [&] { return makeHighCutCoefficients(chainSettings, sampleRate); });
+}
+
+BiquadCoefficients CoefficientCache::getPeakCoefficients(const ChainSettings& chainSettings, double sampleRate) noexcept
+{
+    auto key = makeKey(Band::peak, sampleRate, chainSettings.peakFreq, chainSettings.peakQuality,
+                       chainSettings.peakGainInDecibels, Slope_12);
+
+    return getOrDesign(key, getNumValues(Band::peak), [&]
+    {
+        CutCoefficients coefficients{};
+        coefficients[0] = makePeakCoefficients(chainSettings, sampleRate);
+        return coefficients;
+    })[0];
+}
+
+template <typename DesignFunction>
+CutCoefficients CoefficientCache::getOrDesign(const Key& key, size_t numValues, DesignFunction&& design) noexcept
+{
+    CutCoefficients coefficients{};
+
+    if (lookUp(key, numValues, coefficients))
+        return coefficients;
+
+    coefficients = design();
+    insert(key, numValues, coefficients);
+
+    return coefficients;
+}
+
+bool CoefficientCache::lookUp(const Key& key, size_t numValues, CutCoefficients& coefficients) noexcept
+{
+    numLookups.fetch_add(1, std::memory_order_relaxed);
+
+    auto firstSlot = getFirstSlot(key);
+
+    for (auto i = firstSlot; i < firstSlot + slotsPerBucket; ++i)
+    {
+        auto& slot = slots[i];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+        //odd while a writer is in the middle of it
+        if ((sequence & 1) != 0)
+            continue;
+
+        if (slot.key[0].load(std::memory_order_relaxed) != key[0]
+            || slot.key[1].load(std::memory_order_relaxed) != key[1]
+            || slot.key[2].load(std::memory_order_relaxed) != key[2])
+            continue;
+
+        for (size_t v = 0; v < numValues; ++v)
+            coefficients[v / 5][v % 5] = slot.values[v].load(std::memory_order_relaxed);
+
+        //a writer got in while the values were copied, they may be half old and half new
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+
+        slot.lastUsed.store(clock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        numHits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+
+void CoefficientCache::insert(const Key& key, size_t numValues, const CutCoefficients& coefficients) noexcept
+{
+    auto firstSlot = getFirstSlot(key);
+
+    //an empty slot if there is one, otherwise the one used least recently
+    auto* victim = &slots[firstSlot];
+
+    for (auto i = firstSlot; i < firstSlot + slotsPerBucket; ++i)
+    {
+        auto& slot = slots[i];
+
+        if (slot.key[0].load(std::memory_order_relaxed) == 0)
+        {
+            victim = &slot;
+            break;
+        }
+
+        if (slot.lastUsed.load(std::memory_order_relaxed) < victim->lastUsed.load(std::memory_order_relaxed))
+            victim = &slot;
+    }
+
+    //another thread is writing this slot, the design just doesn't get cached this time
+    auto sequence = victim->sequence.load(std::memory_order_relaxed);
+
+    if ((sequence & 1) != 0 || ! victim->sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+        return;
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (victim->key[0].load(std::memory_order_relaxed) != 0)
+        numEvictions.fetch_add(1, std::memory_order_relaxed);
+
+    for (size_t k = 0; k < key.size(); ++k)
+        victim->key[k].store(key[k], std::memory_order_relaxed);
+
+    for (size_t v = 0; v < numValues; ++v)
+        victim->values[v].store(coefficients[v / 5][v % 5], std::memory_order_relaxed);
+
+    victim->lastUsed.store(clock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    victim->sequence.store(sequence + 2, std::memory_order_release);
+
+    numInsertions.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<const CutFilterTable> CoefficientCache::getCutFilterTable(double sampleRate)
+{
+    const juce::ScopedLock lock(tableLock);
+
+    //rates nobody runs at any more
+    tables.erase(std::remove_if(tables.begin(), tables.end(), [](const auto& entry) { return entry.second.expired(); }),
+                 tables.end());
+
+    for (const auto& [rate, weakTable] : tables)
+        if (rate == sampleRate)
+            if (auto table = weakTable.lock())
+                return table;
+
+    auto table = std::make_shared<CutFilterTable>();
+    table->prepare(sampleRate);
+
+    tables.emplace_back(sampleRate, table);
+    return table;
+}
+
+CoefficientCache::Statistics CoefficientCache::getStatistics() const
+{
+    Statistics statistics;
+
+    statistics.lookups = numLookups.load();
+    statistics.hits = numHits.load();
+    statistics.insertions = numInsertions.load();
+    statistics.evictions = numEvictions.load();
+    statistics.cacheBytes = sizeof(slots);
+
+    for (const auto& slot : slots)
+        if (slot.key[0].load(std::memory_order_relaxed) != 0)
+            ++statistics.numEntries;
+
+    const juce::ScopedLock lock(tableLock);
+
+    for (const auto& entry : tables)
+    {
+        auto numUsers = entry.second.use_count();
+
+        if (auto table = entry.second.lock())
+        {
+            ++statistics.numTables;
+            statistics.tableBytes += table->getMemoryFootprint();
+            statistics.bytesSaved += (size_t) (numUsers - 1) * table->getMemoryFootprint();
+        }
+    }
+
+    return statistics;
+}
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    CoefficientCache.h
+
+    Finished band designs shared by every instance in the process.
+
+    A session often has dozens of instances with the same settings, like the
+    same 80 Hz low cut on every vocal track, and each one used to design it
+    again. The cache keeps each design once, keyed by the sample rate, band,
+    frequency, Q, gain and slope, and hands out copies. It lives as long as
+    some instance holds it through a SharedResourcePointer.
+
+    The designs sit in a fixed table of slots that is never resized, grouped
+    in buckets of a few slots. A lookup only reads and never waits. Each slot
+    is guarded by a sequence number that is odd while it is being written,
+    so a reader that overlaps a writer just sees a miss. A full bucket
+    replaces its least recently used slot, so eviction is part of an insert
+    and needs no allocation or freeing. Only the designer and the message
+    thread use it, the audio thread never does.
+
+    The cut filter lookup tables are shared here too, one per sample rate,
+    reference counted so the last instance to let go of a rate frees it.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CutFilterTable.h"
+
+class CoefficientCache
+{
+public:
+    static constexpr int numSlots = 1024;
+    static constexpr int slotsPerBucket = 8;
+
+    //looked up, or designed and stored when nobody designed them yet
+    CutCoefficients getLowCutCoefficients(const ChainSettings& chainSettings, double sampleRate) noexcept;
+    CutCoefficients getHighCutCoefficients(const ChainSettings& chainSettings, double sampleRate) noexcept;
+    BiquadCoefficients getPeakCoefficients(const ChainSettings& chainSettings, double sampleRate) noexcept;
+
+    //message thread or designer: the table for a rate, built if no instance holds one for it
+    std::shared_ptr<const CutFilterTable> getCutFilterTable(double sampleRate);
+
+    struct Statistics
+    {
+        juce::uint64 lookups{ 0 }, hits{ 0 }, insertions{ 0 }, evictions{ 0 };
+        int numEntries{ 0 };
+
+        //the fixed size of the slot table
+        size_t cacheBytes{ 0 };
+
+        //the shared cut filter tables, and what the instances sharing them would hold if each had its own
+        int numTables{ 0 };
+        size_t tableBytes{ 0 };
+        size_t bytesSaved{ 0 };
+
+        double getHitRate() const noexcept { return lookups > 0 ? (double) hits / (double) lookups : 0.0; }
+    };
+
+    Statistics getStatistics() const;
+
+private:
+    enum class Band : juce::uint32
+    {
+        lowCut = 1,
+        highCut,
+        peak
+    };
+
+    //packed into words so a key compares, hashes and stores without padding, word 0 is never 0 for a real key
+    using Key = std::array<juce::uint64, 3>;
+
+    static Key makeKey(Band band, double sampleRate, float frequency, float quality, float gainInDecibels, Slope slope) noexcept;
+
+    //the first slot of the bucket the key belongs in
+    static size_t getFirstSlot(const Key& key) noexcept;
+
+    //a peak only uses the first section
+    static size_t getNumValues(Band band) noexcept { return band == Band::peak ? 5 : 20; }
+
+    bool lookUp(const Key& key, size_t numValues, CutCoefficients& coefficients) noexcept;
+    void insert(const Key& key, size_t numValues, const CutCoefficients& coefficients) noexcept;
+
+    template <typename DesignFunction>
+    CutCoefficients getOrDesign(const Key& key, size_t numValues, DesignFunction&& design) noexcept;
+
+    struct Slot
+    {
+        std::atomic<juce::uint32> sequence{ 0 };
+        std::atomic<juce::uint32> lastUsed{ 0 };
+        std::array<std::atomic<juce::uint64>, 3> key{};
+        std::array<std::atomic<double>, 20> values{};
+    };
+
+    std::array<Slot, (size_t) numSlots> slots;
+    std::atomic<juce::uint32> clock{ 0 };
+
+    std::atomic<juce::uint64> numLookups{ 0 }, numHits{ 0 }, numInsertions{ 0 }, numEvictions{ 0 };
+
+    //only touched when a designer changes rate, never per design
+    juce::CriticalSection tableLock;
+    std::vector<std::pair<double, std::weak_ptr<const CutFilterTable>>> tables;
+};
@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+    CoefficientDesigner.cpp
+
+  ==============================================================================
+*/
+
+#include "CoefficientDesigner.h"
+
+namespace
+{
+    //how often the worker looks at the parameters, in ms
+    //the host may change parameters from the audio thread, so the cache can't wake the worker up
+    constexpr int activePollInterval = 1;
+    constexpr int idlePollInterval = 5;
+}
+
+CoefficientDesignerThread::CoefficientDesignerThread()
+    : juce::TimeSliceThread("SimpleEQ Coefficient Designer")
+{
+    startThread();
+}
+
+CoefficientDesignerThread::~CoefficientDesignerThread()
+{
+    stopThread(1000);
+}
+
+//==============================================================================
+CoefficientDesigner::CoefficientDesigner(ParameterCache& parameterCache)
+    : parameters(parameterCache)
+{
+}
+
+CoefficientDesigner::~CoefficientDesigner()
+{
+    release();
+}
+
+void CoefficientDesigner::prepare(double newSampleRate)
+{
+    //removing the client waits for a running time slice to finish, so the worker is out of the way after this
+    release();
+
+    hostSampleRate = newSampleRate;
+    setOversamplingOrder(parameters.getOversamplingOrder());
+
+    //sized up front so switching to linear phase while playing doesn't wait on the allocations
+    linearPhaseDesigner.prepare(hostSampleRate);
+    isLinearPhase = parameters.isLinearPhase();
+
+    parameters.consumeDirtyBands();
+    designAll();
+
+    thread->addTimeSliceClient(this);
+    isRegistered = true;
+}
+
+void CoefficientDesigner::release()
+{
+    if (isRegistered)
+    {
+        thread->removeTimeSliceClient(this);
+        isRegistered = false;
+    }
+}
+
+void CoefficientDesigner::setUseCutFilterTable(bool shouldUseTable)
+{
+    if (useCutFilterTable != shouldUseTable)
+        updateWhileReleased([&]
+        {
+            useCutFilterTable = shouldUseTable;
+
+            //other instances may still hold the table, it's only freed when the last one lets go
+            if (! useCutFilterTable)
+                cutFilterTable.reset();
+        });
+}
+
+size_t CoefficientDesigner::getCutFilterTableFootprint() const noexcept
+{
+    return useCutFilterTable && cutFilterTable != nullptr ? cutFilterTable->getMemoryFootprint() : 0;
+}
+
+void CoefficientDesigner::setChannelGroupSettings(ChannelGroup group, const ChainSettings& settings)
+{
+    updateWhileReleased([&] { groupSettings[(size_t) group] = settings; });
+}
+
+void CoefficientDesigner::linkChannelGroup(ChannelGroup group)
+{
+    updateWhileReleased([&] { groupSettings[(size_t) group].reset(); });
+}
+
+int CoefficientDesigner::useTimeSlice()
+{
+    auto dirtyBands = parameters.consumeDirtyBands();
+
+    if (dirtyBands == 0)
+        return idlePollInterval;
+
+    //a new factor changes the rate every set is designed for, the table rebuild is fine here off the audio thread
+    auto order = parameters.getOversamplingOrder();
+    auto linearPhase = parameters.isLinearPhase();
+
+    if (order != oversamplingOrder || linearPhase != isLinearPhase)
+    {
+        setOversamplingOrder(order);
+        isLinearPhase = linearPhase;
+        designAll();
+        return activePollInterval;
+    }
+
+    design(dirtyBands);
+    return activePollInterval;
+}
+
+void CoefficientDesigner::setOversamplingOrder(int order)
+{
+    oversamplingOrder = order;
+    sampleRate = hostSampleRate * (1 << order);
+
+    //another instance at this rate may have built the table already
+    if (useCutFilterTable)
+        cutFilterTable = cache->getCutFilterTable(sampleRate);
+}
+
+void CoefficientDesigner::designBands(FilterCoefficientSet& set, const ChainSettings& chainSettings, int bands) const noexcept
+{
+    //only the settings of the bands designed here are taken, a parameter of another band may have moved since its
+    //dirty flag was consumed, and that band keeps the settings its coefficients were designed from until its turn comes
+    if (bands & ParameterCache::lowCutBand)
+    {
+        set.lowCut = useCutFilterTable ? cutFilterTable->makeLowCutCoefficients(chainSettings.lowCutFreq, chainSettings.lowCutSlope)
+                                       : cache->getLowCutCoefficients(chainSettings, sampleRate);
+        set.lowCutSlope = chainSettings.lowCutSlope;
+        set.settings.lowCutFreq = chainSettings.lowCutFreq;
+        set.settings.lowCutSlope = chainSettings.lowCutSlope;
+    }
+
+    if (bands & ParameterCache::peakBand)
+    {
+        set.peak = cache->getPeakCoefficients(chainSettings, sampleRate);
+        set.settings.peakFreq = chainSettings.peakFreq;
+        set.settings.peakGainInDecibels = chainSettings.peakGainInDecibels;
+        set.settings.peakQuality = chainSettings.peakQuality;
+    }
+
+    if (bands & ParameterCache::highCutBand)
+    {
+        set.highCut = useCutFilterTable ? cutFilterTable->makeHighCutCoefficients(chainSettings.highCutFreq, chainSettings.highCutSlope)
+                                        : cache->getHighCutCoefficients(chainSettings, sampleRate);
+        set.highCutSlope = chainSettings.highCutSlope;
+        set.settings.highCutFreq = chainSettings.highCutFreq;
+        set.settings.highCutSlope = chainSettings.highCutSlope;
+    }
+}
+
+void CoefficientDesigner::design(int dirtyBands)
+{
+    //the parameters are designed once, however many groups are linked to them
+    designBands(linkedSet, parameters.getChainSettings(), dirtyBands);
+
+    for (size_t group = 0; group < currentSets.size(); ++group)
+    {
+        if (! groupSettings[group].has_value())
+            currentSets[group] = linkedSet;
+
+        currentSets[group].oversamplingOrder = oversamplingOrder;
+        currentSets[group].isLinearPhase = isLinearPhase;
+    }
+
+    //the kernels go first, so they're already there when the audio thread sees sets that need them
+    if (isLinearPhase)
+        linearPhaseDesigner.design(currentSets, sampleRate);
+
+    //a handful of logs per group, the processor reports it to the host and waits this long before going idle
+    auto tailSamples = 0.0;
+
+    for (const auto& set : currentSets)
+        tailSamples = juce::jmax(tailSamples, getDecayLength(set, silenceThreshold));
+
+    tailLengthSeconds.store(tailSamples / sampleRate, std::memory_order_relaxed);
+
+    //the sets are plain values, so nothing has to be freed here or on the audio thread when the reader moves on
+    coefficients.getWriteBuffer() = currentSets;
+    coefficients.publish();
+}
+
+void CoefficientDesigner::designAll()
+{
+    for (size_t group = 0; group < currentSets.size(); ++group)
+        if (groupSettings[group].has_value())
+        {
+            designBands(currentSets[group], *groupSettings[group], ParameterCache::allBands);
+            currentSets[group].isLinked = false;
+        }
+
+    design(ParameterCache::allBands);
+}
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    CoefficientDesigner.h
+
+    Designs the filter coefficients off the audio thread.
+
+    Every instance registers with one worker thread shared by the whole
+    process. The worker polls the ParameterCache for bands that changed,
+    redesigns only those and publishes a complete FilterCoefficientSet through
+    a TripleBuffer, so all the audio thread does is pick up the newest set.
+
+    There is one set per ChannelGroup. Linked groups follow the parameters,
+    the others keep the settings they were given.
+
+    The sets are designed for the oversampled rate and say which oversampling
+    order they were designed for, so the audio thread switches rate at the
+    same moment it picks up coefficients that match it.
+
+    In linear phase mode the worker also designs an FIR kernel per group from
+    the sets and publishes the kernels just before the sets.
+
+    The band designs and the cut filter tables come from the CoefficientCache,
+    so instances with the same settings only design them once between them.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FilterCoefficients.h"
+#include "CoefficientCache.h"
+#include "ChannelGroups.h"
+#include "ParameterCache.h"
+#include "TripleBuffer.h"
+#include "LinearPhaseFilter.h"
+
+using ChannelGroupCoefficients = std::array<FilterCoefficientSet, numChannelGroups>;
+
+//one worker shared by every instance in the process
+struct CoefficientDesignerThread : public juce::TimeSliceThread
+{
+    CoefficientDesignerThread();
+    ~CoefficientDesignerThread() override;
+};
+
+class CoefficientDesigner : private juce::TimeSliceClient
+{
+public:
+    explicit CoefficientDesigner(ParameterCache& parameterCache);
+    ~CoefficientDesigner() override;
+
+    //message thread: designs every band for the new host rate and publishes the result before returning
+    void prepare(double sampleRate);
+
+    //message thread: stops watching the parameters until the next prepare
+    void release();
+
+    //message thread: designs the cut filters from a lookup table built for the current sample rate
+    void setUseCutFilterTable(bool shouldUseTable);
+    bool isUsingCutFilterTable() const noexcept { return useCutFilterTable; }
+
+    //bytes held by the lookup table, 0 while it isn't in use
+    size_t getCutFilterTableFootprint() const noexcept;
+
+    //message thread: gives a group its own settings instead of following the parameters
+    void setChannelGroupSettings(ChannelGroup group, const ChainSettings& settings);
+
+    //message thread: makes a group follow the parameters again
+    void linkChannelGroup(ChannelGroup group);
+
+    //audio thread: the newest coefficient sets, or nullptr if nothing changed since the last call
+    const ChannelGroupCoefficients* acquireCoefficients() noexcept { return coefficients.acquire(); }
+
+    //audio thread: the newest linear phase kernels, or nullptr if nothing changed since the last call
+    const LinearPhaseKernels* acquireKernels() noexcept { return linearPhaseDesigner.acquireKernels(); }
+
+    //any thread: how long the longest ringing group in the newest sets takes to fall to silenceThreshold
+    double getTailLengthSeconds() const noexcept { return tailLengthSeconds.load(std::memory_order_relaxed); }
+
+private:
+    int useTimeSlice() override;
+
+    //redesigns the flagged bands of the linked groups and publishes every group
+    void design(int dirtyBands);
+
+    //redesigns every band of every group and publishes them
+    void designAll();
+
+    void designBands(FilterCoefficientSet& set, const ChainSettings& chainSettings, int bands) const noexcept;
+
+    //moves the design rate to the host rate times 2^order, picking up the shared lookup table for it if it's in use
+    void setOversamplingOrder(int order);
+
+    //runs a change to the design inputs with the worker out of the way, then redesigns everything
+    template <typename Function>
+    void updateWhileReleased(Function&& change)
+    {
+        auto wasRegistered = isRegistered;
+        release();
+
+        change();
+
+        if (wasRegistered)
+            prepare(hostSampleRate);
+    }
+
+    ParameterCache& parameters;
+    juce::SharedResourcePointer<CoefficientDesignerThread> thread;
+
+    //the rate the host runs at, and the oversampled rate the coefficients are designed for
+    double hostSampleRate{ 0 };
+    double sampleRate{ 0 };
+    int oversamplingOrder{ 0 };
+
+    bool isLinearPhase{ false };
+    LinearPhaseDesigner linearPhaseDesigner;
+    bool isRegistered{ false };
+
+    //shared by every instance in the process
+    juce::SharedResourcePointer<CoefficientCache> cache;
+
+    bool useCutFilterTable{ false };
+    std::shared_ptr<const CutFilterTable> cutFilterTable;
+
+    //groups with settings of their own, the rest are linked to the parameters
+    std::array<std::optional<ChainSettings>, numChannelGroups> groupSettings;
+
+    //only touched by whichever thread is designing: the worker, or the message thread while unregistered
+    FilterCoefficientSet linkedSet;
+    ChannelGroupCoefficients currentSets;
+
+    TripleBuffer<ChannelGroupCoefficients> coefficients;
+    std::atomic<double> tailLengthSeconds{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CoefficientDesigner)
+};
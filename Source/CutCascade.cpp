@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    CutCascade.cpp
+
+  ==============================================================================
+*/
+
+#include "CutCascade.h"
+
+template <typename SampleType>
+CutCascade<SampleType>::CutCascade() noexcept
+    : processFunction(&CutCascade::processSections<1>)
+{
+}
+
+template <typename SampleType>
+void CutCascade<SampleType>::prepare(const juce::dsp::ProcessSpec& spec) noexcept
+{
+    jassert(spec.numChannels == 1);
+    juce::ignoreUnused(spec);
+
+    reset();
+}
+
+template <typename SampleType>
+void CutCascade<SampleType>::reset() noexcept
+{
+    for (auto& section : sections)
+        section.s1 = section.s2 = 0;
+}
+
+template <typename SampleType>
+void CutCascade<SampleType>::setCoefficients(const CutCoefficients& coefficients, Slope slope) noexcept
+{
+    auto newNumSections = getNumCutSections(slope);
+
+    if (newNumSections != numSections)
+    {
+        //sections that come in start from silence rather than from whatever they held when they were last used
+        for (auto i = numSections; i < newNumSections; ++i)
+            sections[(size_t) i].s1 = sections[(size_t) i].s2 = 0;
+
+        numSections = newNumSections;
+
+        switch (slope)
+        {
+            case Slope_12: processFunction = &CutCascade::processSections<1>; break;
+            case Slope_24: processFunction = &CutCascade::processSections<2>; break;
+            case Slope_36: processFunction = &CutCascade::processSections<3>; break;
+            case Slope_48: processFunction = &CutCascade::processSections<4>; break;
+        }
+    }
+
+    for (int i = 0; i < numSections; ++i)
+    {
+        auto& section = sections[(size_t) i];
+        const auto& c = coefficients[(size_t) i];
+
+        section.b0 = static_cast<SampleType>(c[0]);
+        section.b1 = static_cast<SampleType>(c[1]);
+        section.b2 = static_cast<SampleType>(c[2]);
+        section.a1 = static_cast<SampleType>(c[3]);
+        section.a2 = static_cast<SampleType>(c[4]);
+    }
+}
+
+template <typename SampleType>
+void CutCascade<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept
+{
+    //the ProcessorChain bypasses a slot through the context, the block is left as it is
+    if (context.isBypassed)
+        return;
+
+    auto block = context.getOutputBlock();
+    jassert(block.getNumChannels() == 1);
+
+    (this->*processFunction)(block.getChannelPointer(0), block.getNumSamples());
+}
+
+template <typename SampleType>
+template <int NumSections>
+void CutCascade<SampleType>::processSections(SampleType* samples, size_t numSamples) noexcept
+{
+    //a local copy the compiler can keep in registers for the whole block
+    std::array<Section, (size_t) NumSections> local;
+    std::copy(sections.begin(), sections.begin() + NumSections, local.begin());
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto x = samples[i];
+
+        for (auto& section : local)
+        {
+            auto y = section.b0 * x + section.s1;
+            section.s1 = section.b1 * x - section.a1 * y + section.s2;
+            section.s2 = section.b2 * x - section.a2 * y;
+            x = y;
+        }
+
+        samples[i] = x;
+    }
+
+    //same denormal guard IIR::Filter applies at the end of a block
+    for (int s = 0; s < NumSections; ++s)
+    {
+        auto& section = sections[(size_t) s];
+        section.s1 = local[(size_t) s].s1;
+        section.s2 = local[(size_t) s].s2;
+
+        JUCE_SNAP_TO_ZERO (section.s1);
+        JUCE_SNAP_TO_ZERO (section.s2);
+    }
+}
+
+template class CutCascade<float>;
+template class CutCascade<double>;
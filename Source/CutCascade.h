@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    CutCascade.h
+
+    The Butterworth sections of one cut band, in the CutFilter slots of the
+    MonoChain.
+
+    A ProcessorChain of four IIR::Filters keeps all four stages whatever the
+    Slope, checks each one's bypass flag every block and reaches the
+    coefficients through a separate reference counted object per stage. Here
+    each section's coefficients and state sit next to each other in one
+    array, and the processing loop is a template on the number of sections.
+    There is one instantiation per Slope. It is picked through a member
+    function pointer only when the slope changes, so the loop has a fixed
+    trip count, no bypass checks and keeps the state in registers.
+
+    The arithmetic is the same transposed direct form II as IIR::Filter.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FilterCoefficients.h"
+
+template <typename SampleType>
+class CutCascade
+{
+public:
+    CutCascade() noexcept;
+
+    //the chain is mono, nothing is sized here
+    void prepare(const juce::dsp::ProcessSpec& spec) noexcept;
+    void reset() noexcept;
+
+    //copies the sections the slope uses, and switches the loop over if the slope changed
+    void setCoefficients(const CutCoefficients& coefficients, Slope slope) noexcept;
+
+    int getNumSections() const noexcept { return numSections; }
+
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept;
+
+private:
+    //7 values per section, the whole float cascade fits in two cache lines
+    struct Section
+    {
+        SampleType b0{ 1 }, b1{ 0 }, b2{ 0 }, a1{ 0 }, a2{ 0 };
+        SampleType s1{ 0 }, s2{ 0 };
+    };
+
+    template <int NumSections>
+    void processSections(SampleType* samples, size_t numSamples) noexcept;
+
+    using ProcessFunction = void (CutCascade::*)(SampleType*, size_t) noexcept;
+
+    std::array<Section, 4> sections;
+    int numSections{ 1 };
+    ProcessFunction processFunction;
+};
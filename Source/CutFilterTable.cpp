@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    CutFilterTable.cpp
+
+  ==============================================================================
+*/
+
+#include "CutFilterTable.h"
+
+CutFilterTable::CutFilterTable()
+{
+    for (int slope = Slope_12; slope <= Slope_48; ++slope)
+    {
+        auto numSections = getNumCutSections(static_cast<Slope>(slope));
+
+        for (int i = 0; i < numSections; ++i)
+            inverseQualities[(size_t) slope][(size_t) i] = 1.0 / getButterworthQuality(numSections, i);
+    }
+}
+
+void CutFilterTable::prepare(double sampleRate)
+{
+    prewarpedFrequencies.resize((size_t) (maxFrequency - minFrequency + 1));
+
+    //keep the prewarp finite if the rate is too low for the top of the range
+    auto highestFrequency = 0.49 * sampleRate;
+
+    for (size_t i = 0; i < prewarpedFrequencies.size(); ++i)
+    {
+        auto frequency = juce::jmin(static_cast<double>(minFrequency + (int) i), highestFrequency);
+        prewarpedFrequencies[i] = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+    }
+}
+
+double CutFilterTable::getPrewarpedFrequency(float frequency) const noexcept
+{
+    jassert(isPrepared());
+
+    auto index = juce::jlimit(0, (int) prewarpedFrequencies.size() - 1, juce::roundToInt(frequency) - minFrequency);
+    return prewarpedFrequencies[(size_t) index];
+}
+
+//same sections as IIR::ArrayCoefficients::makeHighPass, with the tan looked up
+CutCoefficients CutFilterTable::makeLowCutCoefficients(float frequency, Slope slope) const noexcept
+{
+    CutCoefficients coefficients;
+    coefficients.fill(identityBiquad);
+
+    auto n = getPrewarpedFrequency(frequency);
+    auto nSquared = n * n;
+
+    for (int i = 0; i < getNumCutSections(slope); ++i)
+    {
+        auto invQ = inverseQualities[(size_t) slope][(size_t) i];
+        auto c1 = 1.0 / (1.0 + invQ * n + nSquared);
+
+        coefficients[(size_t) i] = { c1, c1 * -2.0, c1, c1 * 2.0 * (nSquared - 1.0), c1 * (1.0 - invQ * n + nSquared) };
+    }
+
+    return coefficients;
+}
+
+//same sections as IIR::ArrayCoefficients::makeLowPass, with the tan looked up
+CutCoefficients CutFilterTable::makeHighCutCoefficients(float frequency, Slope slope) const noexcept
+{
+    CutCoefficients coefficients;
+    coefficients.fill(identityBiquad);
+
+    auto n = 1.0 / getPrewarpedFrequency(frequency);
+    auto nSquared = n * n;
+
+    for (int i = 0; i < getNumCutSections(slope); ++i)
+    {
+        auto invQ = inverseQualities[(size_t) slope][(size_t) i];
+        auto c1 = 1.0 / (1.0 + invQ * n + nSquared);
+
+        coefficients[(size_t) i] = { c1, c1 * 2.0, c1, c1 * 2.0 * (1.0 - nSquared), c1 * (1.0 - invQ * n + nSquared) };
+    }
+
+    return coefficients;
+}
+
+size_t CutFilterTable::getMemoryFootprint() const noexcept
+{
+    return prewarpedFrequencies.capacity() * sizeof(double) + sizeof(inverseQualities);
+}
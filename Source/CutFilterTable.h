@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    CutFilterTable.h
+
+    Lookup table for the low and high cut Butterworth designs.
+
+    The cut frequencies move in 1 Hz steps between 20 Hz and 20 kHz, so the
+    only expensive part of a section design, the prewarped frequency
+    tan(pi * f / fs), can be worked out once per sample rate. The Butterworth
+    Q of every section for each Slope is fixed, so a design becomes a table
+    read plus a handful of multiplies per section.
+
+    Storing the finished sections for every frequency and slope would take
+    around 16 MB per sample rate (20 sections of 5 doubles per frequency); the
+    prewarped frequencies give the same designs from a flat 160 KB table.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FilterCoefficients.h"
+
+class CutFilterTable
+{
+public:
+    //range and step of the "LowCut Freq" and "HighCut Freq" parameters
+    static constexpr int minFrequency = 20;
+    static constexpr int maxFrequency = 20000;
+
+    CutFilterTable();
+
+    //fills the table for a sample rate, allocates so call it off the audio thread
+    void prepare(double sampleRate);
+
+    bool isPrepared() const noexcept { return ! prewarpedFrequencies.empty(); }
+
+    //frequency is rounded to the nearest table entry
+    CutCoefficients makeLowCutCoefficients(float frequency, Slope slope) const noexcept;
+    CutCoefficients makeHighCutCoefficients(float frequency, Slope slope) const noexcept;
+
+    //bytes held by the table
+    size_t getMemoryFootprint() const noexcept;
+
+private:
+    double getPrewarpedFrequency(float frequency) const noexcept;
+
+    //tan(pi * f / fs) for every whole frequency from minFrequency to maxFrequency
+    std::vector<double> prewarpedFrequencies;
+
+    //1 / Q of every section, indexed by [slope][section]
+    std::array<std::array<double, 4>, 4> inverseQualities{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CutFilterTable)
+};
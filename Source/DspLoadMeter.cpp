@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    DspLoadMeter.cpp
+
+  ==============================================================================
+*/
+
+#include "DspLoadMeter.h"
+
+const char* DspLoadMeter::getStageName(Stage stage) noexcept
+{
+    switch (stage)
+    {
+        case Stage::parameterFetch:     return "parameterFetch";
+        case Stage::coefficientDesign:  return "coefficientDesign";
+        case Stage::coefficientCopy:    return "coefficientCopy";
+        case Stage::processing:         return "processing";
+        case Stage::numStages:          break;
+    }
+
+    return "total";
+}
+
+double DspLoadMeter::getCounterFrequency()
+{
+   #if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG || JUCE_MSVC)
+    //an invariant TSC ticks at a fixed rate whatever the core's clock is doing, but nothing reports the rate
+    static const double frequency = []
+    {
+        auto startTicks = juce::Time::getHighResolutionTicks();
+        auto startCount = readCounter();
+
+        juce::Thread::sleep(20);
+
+        auto count = readCounter() - startCount;
+        return (double) count / juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    }();
+
+    return frequency;
+   #elif JUCE_ARM && JUCE_64BIT && (JUCE_GCC || JUCE_CLANG)
+    juce::uint64 frequency;
+    asm volatile ("mrs %0, cntfrq_el0" : "=r" (frequency));
+    return (double) frequency;
+   #else
+    return (double) juce::Time::getHighResolutionTicksPerSecond();
+   #endif
+}
+
+void DspLoadMeter::prepare(double sampleRate)
+{
+    jassert(sampleRate > 0);
+
+    countsPerSample = getCounterFrequency() / sampleRate;
+
+    for (auto& block : history)
+        for (auto& value : block)
+            value.store(0.f, std::memory_order_relaxed);
+
+    numBlocksWritten = 0;
+}
+
+DspLoadMeter::ScopedBlock::ScopedBlock(DspLoadMeter& meterToUse, int numSamplesInBlock) noexcept
+    : meter(meterToUse), numSamples(numSamplesInBlock)
+{
+    //an empty block has no budget to measure against
+    meter.isTiming = meter.isEnabled() && numSamples > 0 && meter.countsPerSample > 0;
+
+    if (! meter.isTiming)
+        return;
+
+    meter.stageCounts.fill(0);
+    start = readCounter();
+}
+
+DspLoadMeter::ScopedBlock::~ScopedBlock() noexcept
+{
+    if (meter.isTiming)
+        meter.endBlock(readCounter() - start, numSamples);
+
+    meter.isTiming = false;
+}
+
+void DspLoadMeter::endBlock(juce::uint64 blockCount, int numSamples) noexcept
+{
+    auto budget = countsPerSample * numSamples;
+    auto& row = history[(size_t) (numBlocksWritten.load(std::memory_order_relaxed) % historySize)];
+
+    //the stages are timed inside the block, so whatever they didn't claim is the processing
+    auto claimed = juce::uint64{ 0 };
+
+    for (size_t stage = 0; stage < stageCounts.size(); ++stage)
+        if (stage != (size_t) Stage::processing)
+            claimed += stageCounts[stage];
+
+    stageCounts[(size_t) Stage::processing] = blockCount - juce::jmin(blockCount, claimed);
+
+    for (size_t stage = 0; stage < stageCounts.size(); ++stage)
+        row[stage].store((float) ((double) stageCounts[stage] / budget), std::memory_order_relaxed);
+
+    row.back().store((float) ((double) blockCount / budget), std::memory_order_relaxed);
+
+    numBlocksWritten.fetch_add(1, std::memory_order_release);
+}
+
+DspLoadMeter::Statistics DspLoadMeter::getStatistics() const
+{
+    Statistics statistics;
+
+    statistics.totalBlocks = numBlocksWritten.load(std::memory_order_acquire);
+    statistics.numBlocks = (int) juce::jmin((juce::uint64) historySize, statistics.totalBlocks);
+
+    if (statistics.numBlocks == 0)
+        return statistics;
+
+    std::vector<float> values((size_t) statistics.numBlocks);
+
+    for (size_t stage = 0; stage < statistics.stages.size(); ++stage)
+    {
+        for (size_t block = 0; block < values.size(); ++block)
+            values[block] = history[block][stage].load(std::memory_order_relaxed);
+
+        std::sort(values.begin(), values.end());
+
+        auto getPercentile = [&values](double percentile)
+        {
+            auto index = (size_t) juce::jlimit(0.0, (double) values.size() - 1, std::ceil(percentile * (double) values.size()) - 1);
+            return (double) values[index];
+        };
+
+        auto& result = statistics.stages[stage];
+        result.p50 = getPercentile(0.5);
+        result.p99 = getPercentile(0.99);
+        result.max = (double) values.back();
+        result.mean = std::accumulate(values.begin(), values.end(), 0.0) / (double) values.size();
+    }
+
+    return statistics;
+}
+
+juce::var DspLoadMeter::toVar(const Statistics& statistics)
+{
+    auto* object = new juce::DynamicObject();
+    object->setProperty("blocks", statistics.numBlocks);
+    object->setProperty("totalBlocks", (juce::int64) statistics.totalBlocks);
+
+    //in percent of the real time budget, which is what a host's meter shows
+    for (size_t stage = 0; stage < statistics.stages.size(); ++stage)
+    {
+        const auto& values = statistics.stages[stage];
+
+        auto* stageObject = new juce::DynamicObject();
+        stageObject->setProperty("p50", values.p50 * 100.0);
+        stageObject->setProperty("p99", values.p99 * 100.0);
+        stageObject->setProperty("max", values.max * 100.0);
+        stageObject->setProperty("mean", values.mean * 100.0);
+
+        object->setProperty(getStageName((Stage) stage), juce::var(stageObject));
+    }
+
+    return juce::var(object);
+}
@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    DspLoadMeter.h
+
+    How much of the audio thread's budget an instance uses, and where.
+
+    processBuffer times each block with the fastest counter the platform
+    has, the TSC on x86 and the virtual counter on 64 bit ARM, and times the
+    parameter fetches, the coefficient designs and the coefficient copies
+    inside it. Whatever is left is the processing itself. Each stage is
+    stored as a fraction of the block's real time budget, numSamples over
+    the sample rate, so 1.0 means the block took as long as it lasts.
+
+    The audio thread writes the last historySize blocks into a ring of
+    relaxed atomics and never waits. getStatistics copies the ring out and
+    works out p50, p99, max and mean for every stage. A block that is
+    written while the ring is copied may be mixed up with the one before,
+    which doesn't matter for statistics over hundreds of blocks.
+
+    A block costs a handful of counter reads and five stores, well under
+    1% of even a small block.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+ #include <x86intrin.h>
+#elif JUCE_INTEL && JUCE_MSVC
+ #include <intrin.h>
+#endif
+
+class DspLoadMeter
+{
+public:
+    enum class Stage
+    {
+        parameterFetch,     //reading the ParameterCache
+        coefficientDesign,  //designs made on the audio thread: parametric bands and smoothed sets
+        coefficientCopy,    //picking up the designer's sets and copying them into the filters
+        processing,         //everything else, the filters themselves
+
+        numStages
+    };
+
+    static constexpr int numStages = (int) Stage::numStages;
+
+    //blocks the rolling statistics cover
+    static constexpr int historySize = 512;
+
+    static const char* getStageName(Stage stage) noexcept;
+
+    //a count that goes up at a fixed rate
+    static juce::uint64 readCounter() noexcept
+    {
+       #if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG || JUCE_MSVC)
+        return (juce::uint64) __rdtsc();
+       #elif JUCE_ARM && JUCE_64BIT && (JUCE_GCC || JUCE_CLANG)
+        juce::uint64 count;
+        asm volatile ("mrs %0, cntvct_el0" : "=r" (count));
+        return count;
+       #else
+        return (juce::uint64) juce::Time::getHighResolutionTicks();
+       #endif
+    }
+
+    //counts per second, the TSC is timed against the high resolution clock once per process
+    static double getCounterFrequency();
+
+    //message thread: sets the budget for a sample rate and clears the history
+    void prepare(double sampleRate);
+
+    //any thread: on by default, picked up at the start of the next block
+    void setEnabled(bool shouldBeEnabled) noexcept { enabled = shouldBeEnabled; }
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    //audio thread: times a whole block, what the stages inside it didn't claim counts as processing
+    class ScopedBlock
+    {
+    public:
+        ScopedBlock(DspLoadMeter& meterToUse, int numSamplesInBlock) noexcept;
+        ~ScopedBlock() noexcept;
+
+    private:
+        DspLoadMeter& meter;
+        int numSamples;
+        juce::uint64 start{ 0 };
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+    };
+
+    //audio thread: adds the time it's alive to a stage of the current block, never nest two
+    class ScopedStage
+    {
+    public:
+        ScopedStage(DspLoadMeter& meterToUse, Stage stageToTime) noexcept
+            : meter(meterToUse), stage(stageToTime), start(meter.isTiming ? readCounter() : 0)
+        {
+        }
+
+        ~ScopedStage() noexcept
+        {
+            if (meter.isTiming)
+                meter.stageCounts[(size_t) stage] += readCounter() - start;
+        }
+
+    private:
+        DspLoadMeter& meter;
+        Stage stage;
+        juce::uint64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+    //fractions of the block budget over the blocks in the history
+    struct StageStatistics
+    {
+        double p50{ 0 }, p99{ 0 }, max{ 0 }, mean{ 0 };
+    };
+
+    struct Statistics
+    {
+        //one per Stage, then the whole block
+        std::array<StageStatistics, (size_t) numStages + 1> stages;
+        int numBlocks{ 0 };
+        juce::uint64 totalBlocks{ 0 };
+
+        const StageStatistics& getTotal() const noexcept { return stages.back(); }
+    };
+
+    //any thread but the audio thread, allocates
+    Statistics getStatistics() const;
+
+    //the statistics as a JSON object, for the offline and benchmark tools
+    static juce::var toVar(const Statistics& statistics);
+
+private:
+    //the whole block goes in the last column
+    void endBlock(juce::uint64 blockCount, int numSamples) noexcept;
+
+    std::atomic<bool> enabled{ true };
+    double countsPerSample{ 0 };
+
+    //audio thread only: whether this block is timed, and what each stage of it took so far
+    bool isTiming{ false };
+    std::array<juce::uint64, (size_t) numStages> stageCounts{};
+
+    std::array<std::array<std::atomic<float>, (size_t) numStages + 1>, (size_t) historySize> history{};
+    std::atomic<juce::uint64> numBlocksWritten{ 0 };
+};
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    DspLoadMeterComponent.cpp
+
+  ==============================================================================
+*/
+
+#include "DspLoadMeterComponent.h"
+
+DspLoadMeterComponent::DspLoadMeterComponent(DspLoadMeter& meter)
+    : loadMeter(meter)
+{
+    startTimerHz(updatesPerSecond);
+}
+
+DspLoadMeterComponent::~DspLoadMeterComponent()
+{
+    stopTimer();
+}
+
+juce::Colour DspLoadMeterComponent::getStageColour(DspLoadMeter::Stage stage)
+{
+    switch (stage)
+    {
+        case DspLoadMeter::Stage::parameterFetch:       return juce::Colours::skyblue;
+        case DspLoadMeter::Stage::coefficientDesign:    return juce::Colours::orange;
+        case DspLoadMeter::Stage::coefficientCopy:      return juce::Colours::yellow;
+        case DspLoadMeter::Stage::processing:           return juce::Colours::limegreen;
+        case DspLoadMeter::Stage::numStages:            break;
+    }
+
+    return juce::Colours::white;
+}
+
+void DspLoadMeterComponent::timerCallback()
+{
+    //nothing new while the host isn't playing, so nothing to redraw
+    auto newStatistics = loadMeter.getStatistics();
+
+    if (newStatistics.totalBlocks == statistics.totalBlocks)
+        return;
+
+    statistics = newStatistics;
+    repaint();
+}
+
+void DspLoadMeterComponent::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+    auto textArea = bounds.removeFromRight(bounds.getWidth() * 0.6f);
+    auto barArea = bounds.reduced(0.f, bounds.getHeight() * 0.3f);
+
+    g.setColour(juce::Colours::black);
+    g.fillRect(barArea);
+
+    auto getWidthForLoad = [&barArea](double load)
+    {
+        return barArea.getWidth() * (float) juce::jlimit(0.0, 1.0, load / fullScaleLoad);
+    };
+
+    //the mean of each stage one after the other, they add up to the mean of the block
+    auto x = barArea.getX();
+
+    for (int stage = 0; stage < DspLoadMeter::numStages; ++stage)
+    {
+        auto width = juce::jmin(getWidthForLoad(statistics.stages[(size_t) stage].mean), barArea.getRight() - x);
+
+        g.setColour(getStageColour((DspLoadMeter::Stage) stage));
+        g.fillRect(x, barArea.getY(), width, barArea.getHeight());
+        x += width;
+    }
+
+    const auto& total = statistics.getTotal();
+
+    g.setColour(juce::Colours::red);
+    g.fillRect(barArea.getX() + getWidthForLoad(total.p99) - 1.f, barArea.getY(), 2.f, barArea.getHeight());
+
+    g.setColour(juce::Colours::grey);
+    g.drawRect(barArea);
+
+    auto toPercent = [](double load) { return juce::String(load * 100.0, 1) + "%"; };
+
+    g.setColour(juce::Colours::white);
+    g.setFont(12.f);
+    g.drawFittedText("DSP " + toPercent(total.p50) + "  p99 " + toPercent(total.p99) + "  max " + toPercent(total.max),
+                     textArea.toNearestInt().withTrimmedLeft(6), juce::Justification::centredLeft, 1);
+}
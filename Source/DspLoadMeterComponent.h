@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    DspLoadMeterComponent.h
+
+    Shows how much of the real time budget the instance uses. The bar is the
+    mean load of the last DspLoadMeter::historySize blocks, split into the
+    stages of processBlock, with a tick at the p99, and the text gives the
+    p50, p99 and max of the whole block.
+
+    It polls the meter a few times a second, working out the statistics on
+    the message thread, so the audio thread never does more for it.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspLoadMeter.h"
+
+class DspLoadMeterComponent : public juce::Component,
+                              private juce::Timer
+{
+public:
+    explicit DspLoadMeterComponent(DspLoadMeter& meter);
+    ~DspLoadMeterComponent() override;
+
+    static constexpr int updatesPerSecond = 4;
+
+    //the bar is full at this share of the budget, a single EQ near it has a problem anyway
+    static constexpr double fullScaleLoad = 0.1;
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    void timerCallback() override;
+
+    static juce::Colour getStageColour(DspLoadMeter::Stage stage);
+
+    DspLoadMeter& loadMeter;
+    DspLoadMeter::Statistics statistics;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DspLoadMeterComponent)
+};
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    DynamicBand.cpp
+
+  ==============================================================================
+*/
+
+#include "DynamicBand.h"
+
+void DynamicBand::prepare(double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+
+    //everything that depends on the rate is worked out again on the next block
+    frequency = quality = 0;
+    attackMs = releaseMs = -1.f;
+
+    reset();
+}
+
+void DynamicBand::reset() noexcept
+{
+    s1 = s2 = 0;
+    envelope = 0;
+    gainOffset = 0;
+}
+
+void DynamicBand::setDetectorBand(double newFrequency, double newQuality) noexcept
+{
+    if (newFrequency == frequency && newQuality == quality)
+        return;
+
+    frequency = newFrequency;
+    quality = newQuality;
+    bandPass = makeBandPassCoefficients(frequency, quality, sampleRate);
+}
+
+void DynamicBand::updateTimeConstants(float newAttackMs, float newReleaseMs) noexcept
+{
+    if (newAttackMs == attackMs && newReleaseMs == releaseMs)
+        return;
+
+    attackMs = newAttackMs;
+    releaseMs = newReleaseMs;
+
+    //one pole coefficients that get about 63% of the way in the given time
+    attackCoefficient = std::exp(-1.0 / (juce::jmax(0.01, (double) attackMs) * 0.001 * sampleRate));
+    releaseCoefficient = std::exp(-1.0 / (juce::jmax(0.01, (double) releaseMs) * 0.001 * sampleRate));
+}
+
+template <typename SampleType>
+double DynamicBand::process(const juce::dsp::AudioBlock<SampleType>& input, const DynamicSettings& settings) noexcept
+{
+    updateTimeConstants(settings.attackMs, settings.releaseMs);
+
+    auto numChannels = input.getNumChannels();
+
+    if (numChannels == 0)
+        return gainOffset;
+
+    //the channels are summed into one detector, so the band moves the same way on every channel
+    auto channelGain = 1.0 / (double) numChannels;
+    const auto& c = bandPass;
+
+    for (size_t i = 0; i < input.getNumSamples(); ++i)
+    {
+        auto x = 0.0;
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            x += (double) input.getChannelPointer(ch)[i];
+
+        x *= channelGain;
+
+        auto y = x * c[0] + s1;
+        s1 = x * c[1] - y * c[3] + s2;
+        s2 = x * c[2] - y * c[4];
+
+        auto level = std::abs(y);
+        auto coefficient = level > envelope ? attackCoefficient : releaseCoefficient;
+        envelope = level + coefficient * (envelope - level);
+    }
+
+    JUCE_SNAP_TO_ZERO(envelope);
+
+    //above the threshold the band moves by (1 - 1 / ratio) dB per dB over, up to the range
+    auto over = juce::Decibels::gainToDecibels(envelope, -100.0) - (double) settings.thresholdInDecibels;
+    auto amount = over > 0 ? over * (1.0 - 1.0 / juce::jmax(1.0, (double) settings.ratio)) : 0.0;
+    auto range = (double) settings.rangeInDecibels;
+
+    gainOffset = range < 0 ? -juce::jmin(amount, -range) : juce::jmin(amount, range);
+
+    return gainOffset;
+}
+
+template double DynamicBand::process(const juce::dsp::AudioBlock<float>&, const DynamicSettings&) noexcept;
+template double DynamicBand::process(const juce::dsp::AudioBlock<double>&, const DynamicSettings&) noexcept;
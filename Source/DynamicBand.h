@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    DynamicBand.h
+
+    Level detector that moves a band's gain, for the dynamic EQ mode of the
+    peak band.
+
+    The detector listens to the channels it's given, either the main input or
+    the sidechain, through a band pass on the band it controls, so only the
+    level around the peak frequency moves the peak. A peak envelope follower
+    with separate attack and release runs every sample. The gain is worked
+    out once per block from the envelope, like a compressor with a ratio and
+    a limit on how far it can move. The processor calls it once per
+    sub-block and only has to update the peak's gain, see PeakGainDesign.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FilterCoefficients.h"
+
+class DynamicBand
+{
+public:
+    //message thread: the detector runs at the host rate, whatever the filters are oversampled to
+    void prepare(double sampleRate) noexcept;
+    void reset() noexcept;
+
+    //audio thread: moves the band pass onto the band being controlled, only redesigned when it moved
+    void setDetectorBand(double frequency, double quality) noexcept;
+
+    //runs the detector over a block of the channels it listens to,
+    //and returns how many dB the band's gain moves by at the end of it
+    template <typename SampleType>
+    double process(const juce::dsp::AudioBlock<SampleType>& input, const DynamicSettings& settings) noexcept;
+
+    double getGainOffset() const noexcept { return gainOffset; }
+
+private:
+    void updateTimeConstants(float newAttackMs, float newReleaseMs) noexcept;
+
+    double sampleRate{ 44100 };
+
+    double frequency{ 0 }, quality{ 0 };
+    BiquadCoefficients bandPass{ identityBiquad };
+    double s1{ 0 }, s2{ 0 };
+
+    //peak level of the band passed signal as a linear gain
+    double envelope{ 0 };
+
+    float attackMs{ -1.f }, releaseMs{ -1.f };
+    double attackCoefficient{ 0 }, releaseCoefficient{ 0 };
+
+    double gainOffset{ 0 };
+};
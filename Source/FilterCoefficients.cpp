@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+    FilterCoefficients.cpp
+
+  ==============================================================================
+*/
+
+#include "FilterCoefficients.h"
+
+namespace
+{
+    using ArrayCoefficients = juce::dsp::IIR::ArrayCoefficients<double>;
+
+    //same normalisation juce::dsp::IIR::Coefficients applies when it is constructed from b0, b1, b2, a0, a1, a2
+    BiquadCoefficients normalise(const std::array<double, 6>& c)
+    {
+        auto a0Inverse = 1.0 / c[3];
+
+        return { c[0] * a0Inverse, c[1] * a0Inverse, c[2] * a0Inverse, c[4] * a0Inverse, c[5] * a0Inverse };
+    }
+}
+
+//matches juce::dsp::FilterDesign::designIIR*HighOrderButterworthMethod for even orders
+double getButterworthQuality(int numSections, int sectionIndex)
+{
+    auto order = 2.0 * numSections;
+
+    return 1.0 / (2.0 * std::cos((2.0 * sectionIndex + 1.0) * juce::MathConstants<double>::pi / (order * 2.0)));
+}
+
+BiquadCoefficients makePeakCoefficients(const ChainSettings& chainSettings, double sampleRate)
+{
+    return normalise(ArrayCoefficients::makePeakFilter(sampleRate,
+        chainSettings.peakFreq,
+        chainSettings.peakQuality,
+        juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels)));
+}
+
+//high pass attenuates lower frequencies
+CutCoefficients makeLowCutCoefficients(const ChainSettings& chainSettings, double sampleRate)
+{
+    CutCoefficients coefficients;
+    coefficients.fill(identityBiquad);
+
+    auto numSections = getNumCutSections(chainSettings.lowCutSlope);
+
+    for (int i = 0; i < numSections; ++i)
+        coefficients[i] = normalise(ArrayCoefficients::makeHighPass(sampleRate,
+            chainSettings.lowCutFreq,
+            getButterworthQuality(numSections, i)));
+
+    return coefficients;
+}
+
+//low pass attenuates higher frequencies
+CutCoefficients makeHighCutCoefficients(const ChainSettings& chainSettings, double sampleRate)
+{
+    CutCoefficients coefficients;
+    coefficients.fill(identityBiquad);
+
+    auto numSections = getNumCutSections(chainSettings.highCutSlope);
+
+    for (int i = 0; i < numSections; ++i)
+        coefficients[i] = normalise(ArrayCoefficients::makeLowPass(sampleRate,
+            chainSettings.highCutFreq,
+            getButterworthQuality(numSections, i)));
+
+    return coefficients;
+}
+
+BiquadCoefficients makeBandCoefficients(const BandSettings& band, double sampleRate)
+{
+    //the shelves take the gain of the whole shelf, the notch ignores it
+    auto gain = juce::Decibels::decibelsToGain((double) band.gainInDecibels);
+    auto frequency = (double) band.frequency;
+    auto quality = (double) band.quality;
+
+    switch (band.type)
+    {
+        case BandType::peak:        return normalise(ArrayCoefficients::makePeakFilter(sampleRate, frequency, quality, gain));
+        case BandType::lowShelf:    return normalise(ArrayCoefficients::makeLowShelf(sampleRate, frequency, quality, gain));
+        case BandType::highShelf:   return normalise(ArrayCoefficients::makeHighShelf(sampleRate, frequency, quality, gain));
+        case BandType::notch:       return normalise(ArrayCoefficients::makeNotch(sampleRate, frequency, quality));
+        case BandType::off:         break;
+    }
+
+    return identityBiquad;
+}
+
+BiquadCoefficients makeBandPassCoefficients(double frequency, double quality, double sampleRate)
+{
+    return normalise(ArrayCoefficients::makeBandPass(sampleRate, frequency, quality));
+}
+
+void PeakGainDesign::setFrequencyAndQuality(double newFrequency, double newQuality, double newSampleRate) noexcept
+{
+    if (newFrequency == frequency && newQuality == quality && newSampleRate == sampleRate)
+        return;
+
+    frequency = newFrequency;
+    quality = newQuality;
+    sampleRate = newSampleRate;
+
+    //the same terms ArrayCoefficients::makePeakFilter works out
+    auto omega = juce::MathConstants<double>::twoPi * juce::jmax(frequency, 2.0) / sampleRate;
+
+    cosTerm = -2.0 * std::cos(omega);
+    alpha = std::sin(omega) / (quality * 2.0);
+}
+
+BiquadCoefficients PeakGainDesign::makeCoefficients(double gainInDecibels) const noexcept
+{
+    //A = sqrt(gain factor) = 10^(dB / 40)
+    auto a = std::exp(gainInDecibels * (std::log(10.0) / 40.0));
+    auto alphaTimesA = alpha * a;
+    auto alphaOverA = alpha / a;
+    auto a0Inverse = 1.0 / (1.0 + alphaOverA);
+
+    return { (1.0 + alphaTimesA) * a0Inverse, cosTerm * a0Inverse, (1.0 - alphaTimesA) * a0Inverse,
+             cosTerm * a0Inverse, (1.0 - alphaOverA) * a0Inverse };
+}
+
+double getDecayLength(const BiquadCoefficients& coefficients, double threshold)
+{
+    jassert(threshold > 0.0 && threshold < 1.0);
+
+    //poles of z^2 + a1 z + a2, a complex pair has radius sqrt(a2), real ones the larger magnitude
+    auto a1 = coefficients[3];
+    auto a2 = coefficients[4];
+    auto discriminant = a1 * a1 - 4.0 * a2;
+    auto radius = discriminant < 0.0 ? std::sqrt(a2) : 0.5 * (std::abs(a1) + std::sqrt(discriminant));
+
+    //no poles, only the two samples of the numerator
+    if (radius <= 0.0)
+        return 2.0;
+
+    if (radius >= 1.0)
+        return std::numeric_limits<double>::infinity();
+
+    return std::log(threshold) / std::log(radius);
+}
+
+double getDecayLength(const FilterCoefficientSet& set, double threshold)
+{
+    auto length = getDecayLength(set.peak, threshold);
+
+    for (int i = 0; i < getNumCutSections(set.lowCutSlope); ++i)
+        length += getDecayLength(set.lowCut[(size_t) i], threshold);
+
+    for (int i = 0; i < getNumCutSections(set.highCutSlope); ++i)
+        length += getDecayLength(set.highCut[(size_t) i], threshold);
+
+    return length;
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    FilterCoefficients.h
+
+    Allocation free coefficient design for the peak and cut filters and the
+    extra parametric bands.
+
+    juce::dsp::IIR::Coefficients::makePeakFilter and the FilterDesign
+    Butterworth helpers return heap allocated, reference counted objects, so
+    they can't be used on the audio thread. These helpers produce the same
+    normalised biquads as plain values that can be copied straight into the
+    coefficient storage a filter already owns.
+
+    The designs are kept in double. Float filters round them when they're
+    copied in, the double precision path runs them as designed.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ChainSettings.h"
+
+//normalised biquad in the order juce::dsp::IIR::Coefficients stores it: b0, b1, b2, a1, a2
+using BiquadCoefficients = std::array<double, 5>;
+
+//one biquad per 12 dB/Oct, the slope decides how many of them are used
+using CutCoefficients = std::array<BiquadCoefficients, 4>;
+
+//biquad that passes the signal through unchanged
+constexpr BiquadCoefficients identityBiquad{ 1.0, 0.0, 0.0, 0.0, 0.0 };
+
+inline int getNumCutSections(Slope slope) { return static_cast<int>(slope) + 1; }
+
+//Q of each second order section of a Butterworth filter with 2 * numSections poles
+double getButterworthQuality(int numSections, int sectionIndex);
+
+BiquadCoefficients makePeakCoefficients(const ChainSettings& chainSettings, double sampleRate);
+CutCoefficients makeLowCutCoefficients(const ChainSettings& chainSettings, double sampleRate);
+CutCoefficients makeHighCutCoefficients(const ChainSettings& chainSettings, double sampleRate);
+
+//the RBJ design for one of the extra bands, identityBiquad while the band is off
+BiquadCoefficients makeBandCoefficients(const BandSettings& band, double sampleRate);
+
+//constant 0 dB peak band pass, for detectors listening to one band
+BiquadCoefficients makeBandPassCoefficients(double frequency, double quality, double sampleRate);
+
+//makePeakCoefficients split in two: the terms that only depend on the frequency and Q are kept,
+//so a new gain costs an exp and two divides instead of a full design
+class PeakGainDesign
+{
+public:
+    //only works the terms out again when something changed
+    void setFrequencyAndQuality(double frequency, double quality, double sampleRate) noexcept;
+
+    //the same biquad makePeakCoefficients gives for this gain
+    BiquadCoefficients makeCoefficients(double gainInDecibels) const noexcept;
+
+private:
+    double frequency{ 0 }, quality{ 0 }, sampleRate{ 0 };
+    double cosTerm{ -2.0 }, alpha{ 0 };         //-2 cos(w) and sin(w) / 2Q
+};
+
+//everything the audio thread needs to update both chains in one go
+struct FilterCoefficientSet
+{
+    CutCoefficients lowCut{};
+    BiquadCoefficients peak{ identityBiquad };
+    CutCoefficients highCut{};
+
+    Slope lowCutSlope{ Slope::Slope_12 }, highCutSlope{ Slope::Slope_12 };
+
+    //the settings the set was designed from, the state variable engine follows these instead of the biquads
+    ChainSettings settings;
+
+    //false when the set belongs to a channel group with settings of its own rather than the parameters
+    bool isLinked{ true };
+
+    //the coefficients were designed for the host rate times 2^oversamplingOrder
+    int oversamplingOrder{ 0 };
+
+    //linear phase kernels for these sets were published before them
+    bool isLinearPhase{ false };
+};
+
+//level the tails are measured down to, -120 dB, and below which the processor treats its input as silent
+constexpr double silenceThreshold = 1.0e-6;
+
+//samples the impulse response of a biquad takes to ring down to threshold, from its slowest pole
+//infinity for a pole on or outside the unit circle
+double getDecayLength(const BiquadCoefficients& coefficients, double threshold);
+
+//the same for every section a set runs, added up since each section rings on what the one before left
+double getDecayLength(const FilterCoefficientSet& set, double threshold);
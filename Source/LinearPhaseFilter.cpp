@@ -0,0 +1,373 @@
+/*
+  ==============================================================================
+
+    LinearPhaseFilter.cpp
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseFilter.h"
+
+namespace
+{
+    //long enough for the steepest low cut at 20 Hz to settle, about 85 ms of latency
+    constexpr double kernelSeconds = 0.17;
+    constexpr int partitionsPerKernel = 16;
+
+    //magnitude of a biquad at normalised angular frequency w
+    double getMagnitude(const BiquadCoefficients& c, double w) noexcept
+    {
+        auto z1 = std::polar(1.0, -w);
+        auto z2 = z1 * z1;
+
+        auto numerator = (double) c[0] + (double) c[1] * z1 + (double) c[2] * z2;
+        auto denominator = 1.0 + (double) c[3] * z1 + (double) c[4] * z2;
+
+        return std::abs(numerator) / std::abs(denominator);
+    }
+
+    //magnitude of every section the IIR chain would run for this set
+    double getMagnitude(const FilterCoefficientSet& set, double w) noexcept
+    {
+        auto magnitude = getMagnitude(set.peak, w);
+
+        for (int i = 0; i < getNumCutSections(set.lowCutSlope); ++i)
+            magnitude *= getMagnitude(set.lowCut[(size_t) i], w);
+
+        for (int i = 0; i < getNumCutSections(set.highCutSlope); ++i)
+            magnitude *= getMagnitude(set.highCut[(size_t) i], w);
+
+        return magnitude;
+    }
+}
+
+LinearPhaseSpec LinearPhaseSpec::forSampleRate(double sampleRate)
+{
+    LinearPhaseSpec spec;
+
+    spec.kernelLength = juce::nextPowerOfTwo(juce::roundToInt(sampleRate * kernelSeconds));
+    spec.numPartitions = partitionsPerKernel;
+    spec.partitionSize = spec.kernelLength / partitionsPerKernel;
+
+    return spec;
+}
+
+//==============================================================================
+void LinearPhaseKernel::prepare(const LinearPhaseSpec& spec)
+{
+    numBins = spec.getNumBins();
+    spectra.assign((size_t) (spec.numPartitions * numBins), {});
+}
+
+void LinearPhaseKernel::copyFrom(const LinearPhaseKernel& other) noexcept
+{
+    jassert(other.spectra.size() == spectra.size());
+    std::copy(other.spectra.begin(), other.spectra.end(), spectra.begin());
+}
+
+//==============================================================================
+void LinearPhaseDesigner::prepare(double hostSampleRate)
+{
+    if (sampleRate == hostSampleRate)
+        return;
+
+    sampleRate = hostSampleRate;
+    spec = LinearPhaseSpec::forSampleRate(sampleRate);
+
+    kernelFFT = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(spec.kernelLength)));
+    partitionFFT = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(2 * spec.partitionSize)));
+
+    //real only transforms work in place on twice their size
+    kernelBuffer.assign((size_t) (2 * spec.kernelLength), 0.f);
+    partitionBuffer.assign((size_t) (4 * spec.partitionSize), 0.f);
+
+    //periodic hann, symmetric around the centre of the kernel
+    window.resize((size_t) spec.kernelLength);
+
+    for (size_t n = 0; n < window.size(); ++n)
+        window[n] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float) n / (float) spec.kernelLength);
+
+    for (auto& kernel : designedKernels)
+        kernel.prepare(spec);
+
+    kernels.forEachBuffer([this](LinearPhaseKernels& buffer)
+    {
+        for (auto& kernel : buffer)
+            kernel.prepare(spec);
+    });
+}
+
+void LinearPhaseDesigner::design(const std::array<FilterCoefficientSet, numChannelGroups>& sets, double designSampleRate) noexcept
+{
+    jassert(kernelFFT != nullptr);
+
+    //linked groups share one design
+    const LinearPhaseKernel* linkedKernel = nullptr;
+
+    for (size_t group = 0; group < sets.size(); ++group)
+    {
+        if (sets[group].isLinked && linkedKernel != nullptr)
+        {
+            designedKernels[group].copyFrom(*linkedKernel);
+            continue;
+        }
+
+        designKernel(sets[group], designSampleRate, designedKernels[group]);
+
+        if (sets[group].isLinked)
+            linkedKernel = &designedKernels[group];
+    }
+
+    auto& writeBuffer = kernels.getWriteBuffer();
+
+    for (size_t group = 0; group < designedKernels.size(); ++group)
+        writeBuffer[group].copyFrom(designedKernels[group]);
+
+    kernels.publish();
+}
+
+void LinearPhaseDesigner::designKernel(const FilterCoefficientSet& set, double designSampleRate, LinearPhaseKernel& kernel) noexcept
+{
+    auto kernelLength = spec.kernelLength;
+    auto* spectrum = reinterpret_cast<std::complex<float>*>(kernelBuffer.data());
+
+    //zero phase spectrum with the magnitude of the IIR chain, the sets may be designed for an oversampled rate
+    for (int bin = 0; bin <= kernelLength / 2; ++bin)
+    {
+        auto w = juce::MathConstants<double>::twoPi * bin * sampleRate / ((double) kernelLength * designSampleRate);
+        spectrum[bin] = { (float) getMagnitude(set, w), 0.f };
+    }
+
+    kernelFFT->performRealOnlyInverseTransform(kernelBuffer.data());
+
+    //the impulse is centred on sample 0, move it to the middle of the kernel and window it
+    auto* impulse = kernelBuffer.data();
+    auto* shifted = kernelBuffer.data() + kernelLength;
+
+    for (int n = 0; n < kernelLength; ++n)
+        shifted[n] = impulse[(n + kernelLength / 2) % kernelLength] * window[(size_t) n];
+
+    //each partition is zero padded to twice its length for overlap-save
+    auto partitionSize = spec.partitionSize;
+
+    for (int partition = 0; partition < spec.numPartitions; ++partition)
+    {
+        std::fill(partitionBuffer.begin(), partitionBuffer.end(), 0.f);
+        std::copy(shifted + partition * partitionSize, shifted + (partition + 1) * partitionSize, partitionBuffer.begin());
+
+        partitionFFT->performRealOnlyForwardTransform(partitionBuffer.data(), true);
+
+        auto* bins = reinterpret_cast<const std::complex<float>*>(partitionBuffer.data());
+        std::copy(bins, bins + spec.getNumBins(), kernel.getPartition(partition));
+    }
+}
+
+//==============================================================================
+void LinearPhaseEngine::prepare(const LinearPhaseSpec& newSpec, const std::vector<ChannelGroup>& channelGroups)
+{
+    spec = newSpec;
+    groups = channelGroups;
+
+    auto partitionSize = (size_t) spec.partitionSize;
+    auto numBins = (size_t) spec.getNumBins();
+
+    channels.resize(groups.size());
+
+    for (auto& channel : channels)
+    {
+        channel.input.assign(2 * partitionSize, 0.f);
+        channel.output.assign(partitionSize, 0.f);
+        channel.delayLine.assign((size_t) spec.numPartitions * numBins, {});
+        channel.tail.assign(numBins, {});
+        channel.fadeTail.assign(numBins, {});
+    }
+
+    fft = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2(2 * spec.partitionSize)));
+    fftBuffer.assign(4 * partitionSize, 0.f);
+    fadeBuffer.assign(partitionSize, 0.f);
+
+    reset();
+}
+
+void LinearPhaseEngine::reset() noexcept
+{
+    for (auto& channel : channels)
+    {
+        std::fill(channel.input.begin(), channel.input.end(), 0.f);
+        std::fill(channel.output.begin(), channel.output.end(), 0.f);
+        std::fill(channel.delayLine.begin(), channel.delayLine.end(), std::complex<float>{});
+        std::fill(channel.tail.begin(), channel.tail.end(), std::complex<float>{});
+        std::fill(channel.fadeTail.begin(), channel.fadeTail.end(), std::complex<float>{});
+    }
+
+    currentKernels = nullptr;
+    nextKernels = nullptr;
+    hasKernels = false;
+    isCrossfadeQueued = false;
+    isCrossfadePending = false;
+    fifoPosition = 0;
+    delayLineIndex = 0;
+    numTailPartitionsDone = 0;
+}
+
+void LinearPhaseEngine::setKernels(const LinearPhaseKernels& newKernels) noexcept
+{
+    //nothing playing yet, so there is nothing to fade from, the tails catch up on the next block
+    if (hasKernels)
+        nextKernels = &newKernels;
+    else
+        currentKernels = &newKernels;
+
+    isCrossfadeQueued = hasKernels;
+    hasKernels = true;
+}
+
+void LinearPhaseEngine::process(const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    auto numChannels = juce::jmin(block.getNumChannels(), channels.size());
+    auto numSamples = (int) block.getNumSamples();
+    auto partitionSize = spec.partitionSize;
+
+    for (int position = 0; position < numSamples;)
+    {
+        auto numToCopy = juce::jmin(partitionSize - fifoPosition, numSamples - position);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = block.getChannelPointer(ch) + position;
+            auto& channel = channels[ch];
+
+            std::copy(data, data + numToCopy, channel.input.data() + partitionSize + fifoPosition);
+            std::copy(channel.output.data() + fifoPosition, channel.output.data() + fifoPosition + numToCopy, data);
+        }
+
+        fifoPosition += numToCopy;
+        position += numToCopy;
+
+        //keeps the tails level with the partition filling up, they're complete by the time it's full
+        advanceTails(numChannels, (spec.numPartitions - 1) * fifoPosition / partitionSize);
+
+        if (fifoPosition == partitionSize)
+        {
+            processPartition(numChannels);
+            fifoPosition = 0;
+        }
+    }
+}
+
+void LinearPhaseEngine::advanceTails(size_t numChannels, int numTailPartitions) noexcept
+{
+    if (! hasKernels)
+        return;
+
+    for (; numTailPartitionsDone < numTailPartitions; ++numTailPartitionsDone)
+    {
+        auto partition = numTailPartitionsDone + 1;
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto& channel = channels[ch];
+            auto group = (size_t) groups[ch];
+
+            multiplyAdd(channel, (*currentKernels)[group], partition, channel.tail.data());
+
+            if (isCrossfadePending)
+                multiplyAdd(channel, (*nextKernels)[group], partition, channel.fadeTail.data());
+        }
+    }
+}
+
+void LinearPhaseEngine::processPartition(size_t numChannels) noexcept
+{
+    auto partitionSize = (size_t) spec.partitionSize;
+    auto numBins = (size_t) spec.getNumBins();
+
+    for (size_t ch = 0; ch < numChannels; ++ch)
+    {
+        auto& channel = channels[ch];
+
+        //overlap-save: the spectrum of the last two partitions of input goes into the delay line
+        std::copy(channel.input.begin(), channel.input.end(), fftBuffer.begin());
+        std::fill(fftBuffer.begin() + (std::ptrdiff_t) (2 * partitionSize), fftBuffer.end(), 0.f);
+        fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+        auto* bins = reinterpret_cast<const std::complex<float>*>(fftBuffer.data());
+        std::copy(bins, bins + numBins, channel.delayLine.data() + (size_t) delayLineIndex * numBins);
+
+        std::copy(channel.input.begin() + (std::ptrdiff_t) partitionSize, channel.input.end(), channel.input.begin());
+
+        if (! hasKernels)
+        {
+            std::fill(channel.output.begin(), channel.output.end(), 0.f);
+            continue;
+        }
+
+        auto group = (size_t) groups[ch];
+
+        //the first kernel partition meets the input that just arrived, the rest was added up while it did
+        multiplyAdd(channel, (*currentKernels)[group], 0, channel.tail.data());
+        inverseTransform(channel.tail, channel.output.data());
+        std::fill(channel.tail.begin(), channel.tail.end(), std::complex<float>{});
+
+        if (! isCrossfadePending)
+            continue;
+
+        //same input through the new kernel, faded in across this partition
+        multiplyAdd(channel, (*nextKernels)[group], 0, channel.fadeTail.data());
+        inverseTransform(channel.fadeTail, fadeBuffer.data());
+        std::fill(channel.fadeTail.begin(), channel.fadeTail.end(), std::complex<float>{});
+
+        for (size_t i = 0; i < partitionSize; ++i)
+        {
+            auto gain = ((float) i + 0.5f) / (float) partitionSize;
+            channel.output[i] += (fadeBuffer[i] - channel.output[i]) * gain;
+        }
+    }
+
+    if (isCrossfadePending)
+    {
+        currentKernels = nextKernels;
+        nextKernels = nullptr;
+        isCrossfadePending = false;
+    }
+
+    //kernels that arrived during this partition get their tails added up over the next one
+    if (isCrossfadeQueued)
+    {
+        isCrossfadeQueued = false;
+        isCrossfadePending = true;
+    }
+
+    delayLineIndex = (delayLineIndex + 1) % spec.numPartitions;
+    numTailPartitionsDone = 0;
+}
+
+void LinearPhaseEngine::multiplyAdd(const Channel& channel, const LinearPhaseKernel& kernel, int partition, std::complex<float>* destination) const noexcept
+{
+    auto numBins = (size_t) spec.getNumBins();
+    auto* sum = reinterpret_cast<float*>(destination);
+
+    //partition p of the kernel meets the input from p partitions before the one going in at delayLineIndex
+    auto inputIndex = (delayLineIndex - partition + spec.numPartitions) % spec.numPartitions;
+
+    auto* x = reinterpret_cast<const float*>(channel.delayLine.data() + (size_t) inputIndex * numBins);
+    auto* h = reinterpret_cast<const float*>(kernel.getPartition(partition));
+
+    //written out rather than with std::complex so the compiler can vectorise it without nan checks
+    for (size_t bin = 0; bin < 2 * numBins; bin += 2)
+    {
+        sum[bin]     += x[bin] * h[bin]     - x[bin + 1] * h[bin + 1];
+        sum[bin + 1] += x[bin] * h[bin + 1] + x[bin + 1] * h[bin];
+    }
+}
+
+void LinearPhaseEngine::inverseTransform(const std::vector<std::complex<float>>& spectrum, float* destination) noexcept
+{
+    auto partitionSize = (size_t) spec.partitionSize;
+
+    std::copy(spectrum.begin(), spectrum.end(), reinterpret_cast<std::complex<float>*>(fftBuffer.data()));
+    fft->performRealOnlyInverseTransform(fftBuffer.data());
+
+    //the first half wrapped around, the second half is the valid output
+    std::copy(fftBuffer.begin() + (std::ptrdiff_t) partitionSize, fftBuffer.begin() + (std::ptrdiff_t) (2 * partitionSize), destination);
+}
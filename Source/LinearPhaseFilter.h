@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    LinearPhaseFilter.h
+
+    Linear phase version of the EQ curve for mastering.
+
+    The designer samples the magnitude response of a FilterCoefficientSet
+    (the same low cut, peak and high cut sections the IIR path runs) and
+    turns it into a windowed, symmetric FIR kernel. The kernel is stored
+    already split into uniform partitions and transformed, and run with
+    uniformly partitioned overlap-save convolution.
+
+    Every kernel partition but the first only meets input that has already
+    arrived, so their multiply-adds are spread evenly over the host blocks
+    that fill the next partition. The block that completes a partition only
+    adds one FFT pair and the first partition's multiply-add. Small host
+    buffers then cost about the same every block, instead of one in every
+    few taking the whole kernel's work.
+
+    Kernels are designed on the coefficient designer's worker and handed
+    over through a TripleBuffer that leaves the reader the last two sets, so
+    the engine plays straight from the published kernels without copying
+    them, and crossfades from the old kernel to the new one over one
+    partition.
+
+    Latency is half the kernel plus one partition.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FilterCoefficients.h"
+#include "ChannelGroups.h"
+#include "TripleBuffer.h"
+
+//kernel and partition sizes for a host sample rate, the designer and the engine work them out the same way
+struct LinearPhaseSpec
+{
+    int kernelLength{ 0 };
+    int partitionSize{ 0 };
+    int numPartitions{ 0 };
+
+    int getNumBins() const noexcept { return partitionSize + 1; }
+    int getLatencySamples() const noexcept { return kernelLength / 2 + partitionSize; }
+
+    static LinearPhaseSpec forSampleRate(double sampleRate);
+};
+
+//the transformed partitions of one FIR kernel
+class LinearPhaseKernel
+{
+public:
+    //allocates, call it off the audio thread
+    void prepare(const LinearPhaseSpec& spec);
+
+    //both kernels have to be prepared with the same spec
+    void copyFrom(const LinearPhaseKernel& other) noexcept;
+
+    const std::complex<float>* getPartition(int index) const noexcept { return spectra.data() + (size_t) (index * numBins); }
+    std::complex<float>* getPartition(int index) noexcept { return spectra.data() + (size_t) (index * numBins); }
+
+private:
+    std::vector<std::complex<float>> spectra;
+    int numBins{ 0 };
+};
+
+using LinearPhaseKernels = std::array<LinearPhaseKernel, numChannelGroups>;
+
+//==============================================================================
+//worker side: designs a kernel per channel group and publishes them
+class LinearPhaseDesigner
+{
+public:
+    //allocates the FFTs and every kernel buffer for the host rate
+    void prepare(double hostSampleRate);
+
+    //designs the kernels from sets designed at designSampleRate and publishes them, doesn't allocate
+    void design(const std::array<FilterCoefficientSet, numChannelGroups>& sets, double designSampleRate) noexcept;
+
+    //audio thread: the newest kernels, or nullptr if nothing was published since the last call
+    //the kernels from the call before stay valid too, until the next set is acquired
+    const LinearPhaseKernels* acquireKernels() noexcept { return kernels.acquire(); }
+
+private:
+    void designKernel(const FilterCoefficientSet& set, double designSampleRate, LinearPhaseKernel& kernel) noexcept;
+
+    LinearPhaseSpec spec;
+    double sampleRate{ 0 };
+
+    std::unique_ptr<juce::dsp::FFT> kernelFFT, partitionFFT;
+    std::vector<float> kernelBuffer, partitionBuffer, window;
+
+    LinearPhaseKernels designedKernels;
+    TripleBuffer<LinearPhaseKernels, 2> kernels;
+};
+
+//==============================================================================
+//audio side: convolves every channel with its group's kernel
+class LinearPhaseEngine
+{
+public:
+    //allocates everything the audio thread will need
+    void prepare(const LinearPhaseSpec& spec, const std::vector<ChannelGroup>& channelGroups);
+
+    //clears the signal and forgets the kernels, the next setKernels loads without a crossfade
+    void reset() noexcept;
+
+    int getLatencySamples() const noexcept { return spec.getLatencySamples(); }
+
+    //false while a crossfade is waiting to run
+    bool isReadyForKernels() const noexcept { return ! isCrossfadeQueued && ! isCrossfadePending; }
+
+    //crossfades to the kernels once a whole partition has been run through them, only keeping a pointer to them
+    //they and the ones playing have to stay valid until isReadyForKernels(), which acquireKernels() takes care of
+    void setKernels(const LinearPhaseKernels& newKernels) noexcept;
+
+    //processes up to as many channels as it was prepared for, in place
+    void process(const juce::dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    struct Channel
+    {
+        std::vector<float> input;                       //the last two partitions of input
+        std::vector<float> output;                      //the partition of output being played out
+        std::vector<std::complex<float>> delayLine;     //spectra of the last numPartitions inputs
+        std::vector<std::complex<float>> tail;          //the next output's spectrum, without the first kernel partition yet
+        std::vector<std::complex<float>> fadeTail;      //the same through the kernels being faded to
+    };
+
+    //adds the kernel partitions after the first to the channels' tails, up to numTailPartitions of them so far
+    void advanceTails(size_t numChannels, int numTailPartitions) noexcept;
+
+    void processPartition(size_t numChannels) noexcept;
+
+    //adds one kernel partition times the input spectrum it meets to destination
+    void multiplyAdd(const Channel& channel, const LinearPhaseKernel& kernel, int partition, std::complex<float>* destination) const noexcept;
+    void inverseTransform(const std::vector<std::complex<float>>& spectrum, float* destination) noexcept;
+
+    LinearPhaseSpec spec;
+
+    std::vector<Channel> channels;
+    std::vector<ChannelGroup> groups;
+
+    //the kernels playing and the ones being faded to, owned by the designer's TripleBuffer
+    const LinearPhaseKernels* currentKernels{ nullptr };
+    const LinearPhaseKernels* nextKernels{ nullptr };
+    bool hasKernels{ false };
+    bool isCrossfadeQueued{ false };        //set mid-partition, the tails for the new kernels start at the next one
+    bool isCrossfadePending{ false };       //the fade tails are being accumulated, the fade runs at the end of this partition
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> fftBuffer, fadeBuffer;
+
+    int fifoPosition{ 0 };
+    int delayLineIndex{ 0 };
+    int numTailPartitionsDone{ 0 };
+};
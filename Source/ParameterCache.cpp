@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    ParameterCache.cpp
+
+  ==============================================================================
+*/
+
+#include "ParameterCache.h"
+
+namespace
+{
+    //every parameter that feeds ChainSettings, plus the processing modes every design depends on
+    const char* const parameterIDs[] = { "LowCut Freq", "HighCut Freq", "Peak Freq", "Peak Gain",
+                                         "Peak Quality", "LowCut Slope", "HighCut Slope", "Oversampling",
+                                         "Linear Phase" };
+
+    //each parametric band has one of these, see getBandParameterID
+    const char* const bandParameterNames[] = { "Type", "Freq", "Gain", "Quality" };
+}
+
+ParameterCache::ParameterCache(juce::AudioProcessorValueTreeState& state)
+    : apvts(state)
+{
+    lowCutFreq = apvts.getRawParameterValue("LowCut Freq");
+    highCutFreq = apvts.getRawParameterValue("HighCut Freq");
+    peakFreq = apvts.getRawParameterValue("Peak Freq");
+    peakGain = apvts.getRawParameterValue("Peak Gain");
+    peakQuality = apvts.getRawParameterValue("Peak Quality");
+    lowCutSlope = apvts.getRawParameterValue("LowCut Slope");
+    highCutSlope = apvts.getRawParameterValue("HighCut Slope");
+    oversampling = apvts.getRawParameterValue("Oversampling");
+    linearPhase = apvts.getRawParameterValue("Linear Phase");
+
+    dynamicEnabled = apvts.getRawParameterValue("Dynamic");
+    dynamicSidechain = apvts.getRawParameterValue("Dynamic Sidechain");
+    dynamicThreshold = apvts.getRawParameterValue("Dynamic Threshold");
+    dynamicRatio = apvts.getRawParameterValue("Dynamic Ratio");
+    dynamicRange = apvts.getRawParameterValue("Dynamic Range");
+    dynamicAttack = apvts.getRawParameterValue("Dynamic Attack");
+    dynamicRelease = apvts.getRawParameterValue("Dynamic Release");
+
+    for (auto* id : parameterIDs)
+        apvts.addParameterListener(id, this);
+
+    for (int band = 0; band < maxParametricBands; ++band)
+    {
+        auto& parameters = bandParameters[(size_t) band];
+
+        parameters.type = apvts.getRawParameterValue(getBandParameterID(band, "Type"));
+        parameters.frequency = apvts.getRawParameterValue(getBandParameterID(band, "Freq"));
+        parameters.gain = apvts.getRawParameterValue(getBandParameterID(band, "Gain"));
+        parameters.quality = apvts.getRawParameterValue(getBandParameterID(band, "Quality"));
+
+        for (auto* name : bandParameterNames)
+            apvts.addParameterListener(getBandParameterID(band, name), this);
+    }
+}
+
+ParameterCache::~ParameterCache()
+{
+    for (auto* id : parameterIDs)
+        apvts.removeParameterListener(id, this);
+
+    for (int band = 0; band < maxParametricBands; ++band)
+        for (auto* name : bandParameterNames)
+            apvts.removeParameterListener(getBandParameterID(band, name), this);
+}
+
+ChainSettings ParameterCache::getChainSettings() const noexcept
+{
+    ChainSettings settings;
+
+    settings.lowCutFreq = lowCutFreq->load();
+    settings.highCutFreq = highCutFreq->load();
+    settings.peakFreq = peakFreq->load();
+    settings.peakGainInDecibels = peakGain->load();
+    settings.peakQuality = peakQuality->load();
+    settings.lowCutSlope = static_cast<Slope>(lowCutSlope->load());
+    settings.highCutSlope = static_cast<Slope>(highCutSlope->load());
+
+    return settings;
+}
+
+int ParameterCache::getOversamplingOrder() const noexcept
+{
+    return static_cast<int>(oversampling->load());
+}
+
+bool ParameterCache::isLinearPhase() const noexcept
+{
+    return linearPhase->load() >= 0.5f;
+}
+
+int ParameterCache::consumeDirtyBands() noexcept
+{
+    if (batchDepth.load() > 0)
+        return 0;
+
+    return dirtyBands.exchange(0);
+}
+
+void ParameterCache::markDirty(int bands) noexcept
+{
+    dirtyBands.fetch_or(bands);
+}
+
+DynamicSettings ParameterCache::getDynamicSettings() const noexcept
+{
+    DynamicSettings settings;
+
+    settings.isEnabled = dynamicEnabled->load() >= 0.5f;
+    settings.useSidechain = dynamicSidechain->load() >= 0.5f;
+    settings.thresholdInDecibels = dynamicThreshold->load();
+    settings.ratio = dynamicRatio->load();
+    settings.rangeInDecibels = dynamicRange->load();
+    settings.attackMs = dynamicAttack->load();
+    settings.releaseMs = dynamicRelease->load();
+
+    return settings;
+}
+
+BandSettings ParameterCache::getBandSettings(int band) const noexcept
+{
+    const auto& parameters = bandParameters[(size_t) band];
+    BandSettings settings;
+
+    settings.type = static_cast<BandType>(static_cast<int>(parameters.type->load()));
+    settings.frequency = parameters.frequency->load();
+    settings.gainInDecibels = parameters.gain->load();
+    settings.quality = parameters.quality->load();
+
+    return settings;
+}
+
+juce::uint32 ParameterCache::consumeDirtyParametricBands() noexcept
+{
+    if (batchDepth.load() > 0)
+        return 0;
+
+    return dirtyParametricBands.exchange(0);
+}
+
+void ParameterCache::markParametricBandsDirty(juce::uint32 bands) noexcept
+{
+    dirtyParametricBands.fetch_or(bands);
+}
+
+//can be called on any thread the host changes parameters from, so it only sets a flag for whoever polls it
+void ParameterCache::parameterChanged(const juce::String& parameterID, float)
+{
+    if (auto band = getParametricBandForParameter(parameterID); band >= 0)
+        markParametricBandsDirty((juce::uint32) 1 << band);
+    else
+        markDirty(getBandForParameter(parameterID));
+}
+
+int ParameterCache::getBandForParameter(const juce::String& parameterID)
+{
+    if (parameterID.startsWith("LowCut"))
+        return lowCutBand;
+
+    if (parameterID.startsWith("HighCut"))
+        return highCutBand;
+
+    if (parameterID.startsWith("Peak"))
+        return peakBand;
+
+    //a new rate or mode changes every band
+    if (parameterID == "Oversampling" || parameterID == "Linear Phase")
+        return allBands;
+
+    jassertfalse;
+    return allBands;
+}
+
+int ParameterCache::getParametricBandForParameter(const juce::String& parameterID) noexcept
+{
+    if (! parameterID.startsWith("Band "))
+        return -1;
+
+    //reads the number straight out of the ID, this can run on the audio thread so nothing is copied
+    auto band = juce::CharacterFunctions::getIntValue<int>(parameterID.getCharPointer() + 5) - 1;
+
+    jassert(band >= 0 && band < maxParametricBands);
+    return juce::jlimit(0, maxParametricBands - 1, band);
+}
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    ParameterCache.h
+
+    Keeps the raw parameter pointers of the APVTS around so ChainSettings can be
+    read without looking parameters up by name, and tracks which bands have been
+    touched since their coefficients were last designed.
+
+    The extra parametric bands are tracked separately, one bit per band, since
+    the processor designs those itself rather than the CoefficientDesigner.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ChainSettings.h"
+
+class ParameterCache : private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    //bit flags for each band that can be redesigned on its own
+    enum Band
+    {
+        lowCutBand  = 1 << 0,
+        peakBand    = 1 << 1,
+        highCutBand = 1 << 2,
+
+        allBands = lowCutBand | peakBand | highCutBand
+    };
+
+    explicit ParameterCache(juce::AudioProcessorValueTreeState& apvts);
+    ~ParameterCache() override;
+
+    //lock and allocation free, safe to call from the audio thread
+    ChainSettings getChainSettings() const noexcept;
+
+    //0 for no oversampling, otherwise the filters run at 2^order times the host rate
+    int getOversamplingOrder() const noexcept;
+
+    //true when the curve should be run as a linear phase FIR instead of the IIR chain
+    bool isLinearPhase() const noexcept;
+
+    //lock and allocation free, the dynamic parameters don't mark anything dirty, the processor reads them every block
+    DynamicSettings getDynamicSettings() const noexcept;
+
+    //returns the bands that changed since the last call and clears them, 0 while a batch is open
+    int consumeDirtyBands() noexcept;
+
+    void markDirty(int bands) noexcept;
+
+    //lock and allocation free, band goes from 0 to maxParametricBands - 1
+    BandSettings getBandSettings(int band) const noexcept;
+
+    //one bit per parametric band
+    static constexpr juce::uint32 allParametricBands = ((juce::uint32) 1 << maxParametricBands) - 1;
+
+    //returns the parametric bands that changed since the last call and clears them, 0 while a batch is open
+    juce::uint32 consumeDirtyParametricBands() noexcept;
+
+    void markParametricBandsDirty(juce::uint32 bands) noexcept;
+
+    //holds the dirty bands back while many parameters change at once, like a state restore,
+    //so whoever consumes them designs each band once from the final values
+    class ScopedBatch
+    {
+    public:
+        explicit ScopedBatch(ParameterCache& cache) noexcept : owner(cache) { ++owner.batchDepth; }
+        ~ScopedBatch() noexcept { --owner.batchDepth; }
+
+    private:
+        ParameterCache& owner;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBatch)
+    };
+
+private:
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    static int getBandForParameter(const juce::String& parameterID);
+
+    //index of the parametric band a parameter belongs to, -1 for the other parameters
+    static int getParametricBandForParameter(const juce::String& parameterID) noexcept;
+
+    juce::AudioProcessorValueTreeState& apvts;
+
+    std::atomic<float>* lowCutFreq{ nullptr };
+    std::atomic<float>* highCutFreq{ nullptr };
+    std::atomic<float>* peakFreq{ nullptr };
+    std::atomic<float>* peakGain{ nullptr };
+    std::atomic<float>* peakQuality{ nullptr };
+    std::atomic<float>* lowCutSlope{ nullptr };
+    std::atomic<float>* highCutSlope{ nullptr };
+    std::atomic<float>* oversampling{ nullptr };
+    std::atomic<float>* linearPhase{ nullptr };
+
+    std::atomic<float>* dynamicEnabled{ nullptr };
+    std::atomic<float>* dynamicSidechain{ nullptr };
+    std::atomic<float>* dynamicThreshold{ nullptr };
+    std::atomic<float>* dynamicRatio{ nullptr };
+    std::atomic<float>* dynamicRange{ nullptr };
+    std::atomic<float>* dynamicAttack{ nullptr };
+    std::atomic<float>* dynamicRelease{ nullptr };
+
+    struct BandParameters
+    {
+        std::atomic<float>* type{ nullptr };
+        std::atomic<float>* frequency{ nullptr };
+        std::atomic<float>* gain{ nullptr };
+        std::atomic<float>* quality{ nullptr };
+    };
+
+    std::array<BandParameters, (size_t) maxParametricBands> bandParameters;
+
+    //everything starts dirty so the first block designs all the filters
+    std::atomic<int> dirtyBands{ allBands };
+    std::atomic<juce::uint32> dirtyParametricBands{ allParametricBands };
+    std::atomic<int> batchDepth{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterCache)
+};
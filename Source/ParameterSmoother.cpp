@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    ParameterSmoother.cpp
+
+  ==============================================================================
+*/
+
+#include "ParameterSmoother.h"
+#include "ParameterCache.h"
+
+void ParameterSmoother::prepare(double sampleRate, double rampLengthSeconds, const ChainSettings& settings) noexcept
+{
+    lowCutFreq.reset(sampleRate, rampLengthSeconds);
+    highCutFreq.reset(sampleRate, rampLengthSeconds);
+    peakFreq.reset(sampleRate, rampLengthSeconds);
+    peakQuality.reset(sampleRate, rampLengthSeconds);
+    peakGain.reset(sampleRate, rampLengthSeconds);
+
+    setCurrentAndTargetSettings(settings);
+}
+
+void ParameterSmoother::setCurrentAndTargetSettings(const ChainSettings& settings) noexcept
+{
+    lowCutFreq.setCurrentAndTargetValue(settings.lowCutFreq);
+    highCutFreq.setCurrentAndTargetValue(settings.highCutFreq);
+    peakFreq.setCurrentAndTargetValue(settings.peakFreq);
+    peakQuality.setCurrentAndTargetValue(settings.peakQuality);
+    peakGain.setCurrentAndTargetValue(settings.peakGainInDecibels);
+
+    lowCutSlope = settings.lowCutSlope;
+    highCutSlope = settings.highCutSlope;
+
+    pendingBands = 0;
+}
+
+void ParameterSmoother::setTargetSettings(const ChainSettings& settings) noexcept
+{
+    lowCutFreq.setTargetValue(settings.lowCutFreq);
+    highCutFreq.setTargetValue(settings.highCutFreq);
+    peakFreq.setTargetValue(settings.peakFreq);
+    peakQuality.setTargetValue(settings.peakQuality);
+    peakGain.setTargetValue(settings.peakGainInDecibels);
+
+    if (settings.lowCutSlope != lowCutSlope)
+    {
+        lowCutSlope = settings.lowCutSlope;
+        pendingBands |= ParameterCache::lowCutBand;
+    }
+
+    if (settings.highCutSlope != highCutSlope)
+    {
+        highCutSlope = settings.highCutSlope;
+        pendingBands |= ParameterCache::highCutBand;
+    }
+}
+
+int ParameterSmoother::advance(int numSamples) noexcept
+{
+    auto changedBands = std::exchange(pendingBands, 0);
+
+    auto step = [numSamples, &changedBands](auto& value, int band)
+    {
+        if (value.isSmoothing())
+        {
+            value.skip(numSamples);
+            changedBands |= band;
+        }
+    };
+
+    step(lowCutFreq, ParameterCache::lowCutBand);
+    step(peakFreq, ParameterCache::peakBand);
+    step(peakGain, ParameterCache::peakBand);
+    step(peakQuality, ParameterCache::peakBand);
+    step(highCutFreq, ParameterCache::highCutBand);
+
+    return changedBands;
+}
+
+ChainSettings ParameterSmoother::getCurrentSettings() const noexcept
+{
+    ChainSettings settings;
+
+    settings.lowCutFreq = lowCutFreq.getCurrentValue();
+    settings.highCutFreq = highCutFreq.getCurrentValue();
+    settings.peakFreq = peakFreq.getCurrentValue();
+    settings.peakQuality = peakQuality.getCurrentValue();
+    settings.peakGainInDecibels = peakGain.getCurrentValue();
+    settings.lowCutSlope = lowCutSlope;
+    settings.highCutSlope = highCutSlope;
+
+    return settings;
+}
+
+bool ParameterSmoother::isSmoothing() const noexcept
+{
+    return pendingBands != 0
+        || lowCutFreq.isSmoothing() || highCutFreq.isSmoothing()
+        || peakFreq.isSmoothing() || peakQuality.isSmoothing() || peakGain.isSmoothing();
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    ParameterSmoother.h
+
+    Ramps the continuous ChainSettings values towards the parameter targets so
+    the coefficients can follow automation in small steps instead of jumping
+    once per host block.
+
+    Frequencies and Q ramp multiplicatively so a sweep sounds even across the
+    range, the peak gain ramps linearly in dB. Slopes can't be interpolated and
+    switch straight away.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ChainSettings.h"
+
+class ParameterSmoother
+{
+public:
+    //sets the ramp length and jumps straight to the given settings
+    void prepare(double sampleRate, double rampLengthSeconds, const ChainSettings& settings) noexcept;
+
+    //jumps straight to the given settings without ramping
+    void setCurrentAndTargetSettings(const ChainSettings& settings) noexcept;
+
+    //starts ramping towards new targets, values that didn't change keep their current ramp
+    void setTargetSettings(const ChainSettings& settings) noexcept;
+
+    //moves every ramp on by numSamples and returns the bands whose values changed (ParameterCache::Band)
+    int advance(int numSamples) noexcept;
+
+    ChainSettings getCurrentSettings() const noexcept;
+
+    bool isSmoothing() const noexcept;
+
+private:
+    using MultiplicativeValue = juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative>;
+    using LinearValue = juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear>;
+
+    MultiplicativeValue lowCutFreq, highCutFreq, peakFreq, peakQuality;
+    LinearValue peakGain;
+
+    Slope lowCutSlope{ Slope_12 }, highCutSlope{ Slope_12 };
+
+    //slope changes waiting to be reported by the next advance()
+    int pendingBands{ 0 };
+};
@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    ParametricBands.cpp
+
+  ==============================================================================
+*/
+
+#include "ParametricBands.h"
+
+template <typename SampleType>
+void ParametricBands<SampleType>::prepare(int newNumBands, int numChannels)
+{
+    jassert(newNumBands >= 0 && newNumBands <= maxParametricBands);
+
+    numBands = newNumBands;
+    numGroups = ((size_t) numChannels + numLanes - 1) / numLanes;
+
+    auto size = (size_t) numBands;
+
+    bandCoefficients.assign(size, { SampleType(1), SampleType(0), SampleType(0), SampleType(0), SampleType(0) });
+    bandSlots.assign(size, -1);
+    newBandSlots.assign(size, -1);
+
+    for (auto* coefficients : { &b0, &b1, &b2, &a1, &a2 })
+        coefficients->assign(size, SampleType(0));
+
+    state1.assign(size * numGroups, Register::expand(SampleType(0)));
+    state2.assign(size * numGroups, Register::expand(SampleType(0)));
+    compactState1.assign(size, Register::expand(SampleType(0)));
+    compactState2.assign(size, Register::expand(SampleType(0)));
+
+    activeBands = 0;
+    numActiveBands = 0;
+    needsCompacting = false;
+}
+
+template <typename SampleType>
+void ParametricBands<SampleType>::reset() noexcept
+{
+    std::fill(state1.begin(), state1.end(), Register::expand(SampleType(0)));
+    std::fill(state2.begin(), state2.end(), Register::expand(SampleType(0)));
+}
+
+template <typename SampleType>
+void ParametricBands<SampleType>::setBand(int band, const BiquadCoefficients& coefficients, bool isActive) noexcept
+{
+    jassert(band >= 0 && band < numBands);
+
+    auto& stored = bandCoefficients[(size_t) band];
+
+    for (size_t i = 0; i < stored.size(); ++i)
+        stored[i] = static_cast<SampleType>(coefficients[i]);
+
+    auto bandBit = (juce::uint32) 1 << band;
+    auto wasActive = (activeBands & bandBit) != 0;
+
+    //a band switching on or off moves the others around, that waits for the next process call
+    if (isActive != wasActive)
+    {
+        activeBands ^= bandBit;
+        needsCompacting = true;
+        return;
+    }
+
+    if (! isActive || needsCompacting)
+        return;
+
+    auto slot = (size_t) bandSlots[(size_t) band];
+
+    b0[slot] = stored[0];
+    b1[slot] = stored[1];
+    b2[slot] = stored[2];
+    a1[slot] = stored[3];
+    a2[slot] = stored[4];
+}
+
+template <typename SampleType>
+void ParametricBands<SampleType>::compact() noexcept
+{
+    numActiveBands = 0;
+
+    for (int band = 0; band < numBands; ++band)
+        newBandSlots[(size_t) band] = (activeBands & ((juce::uint32) 1 << band)) != 0 ? numActiveBands++ : -1;
+
+    //bands that stay on keep their state in their new slot, the ones coming on start from silence
+    for (size_t group = 0; group < numGroups; ++group)
+    {
+        auto* groupState1 = state1.data() + group * (size_t) numBands;
+        auto* groupState2 = state2.data() + group * (size_t) numBands;
+
+        for (size_t band = 0; band < (size_t) numBands; ++band)
+        {
+            auto newSlot = newBandSlots[band];
+
+            if (newSlot < 0)
+                continue;
+
+            auto oldSlot = bandSlots[band];
+
+            compactState1[(size_t) newSlot] = oldSlot >= 0 ? groupState1[oldSlot] : Register::expand(SampleType(0));
+            compactState2[(size_t) newSlot] = oldSlot >= 0 ? groupState2[oldSlot] : Register::expand(SampleType(0));
+        }
+
+        std::copy(compactState1.begin(), compactState1.begin() + numActiveBands, groupState1);
+        std::copy(compactState2.begin(), compactState2.begin() + numActiveBands, groupState2);
+    }
+
+    for (size_t band = 0; band < (size_t) numBands; ++band)
+    {
+        auto slot = newBandSlots[band];
+        bandSlots[band] = slot;
+
+        if (slot < 0)
+            continue;
+
+        const auto& c = bandCoefficients[band];
+
+        b0[(size_t) slot] = c[0];
+        b1[(size_t) slot] = c[1];
+        b2[(size_t) slot] = c[2];
+        a1[(size_t) slot] = c[3];
+        a2[(size_t) slot] = c[4];
+    }
+
+    needsCompacting = false;
+}
+
+template <typename SampleType>
+void ParametricBands<SampleType>::process(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    if (needsCompacting)
+        compact();
+
+    if (numActiveBands == 0)
+        return;
+
+    auto numChannels = juce::jmin(block.getNumChannels(), numGroups * numLanes);
+    auto numSamples = block.getNumSamples();
+
+    for (size_t first = 0; first < numChannels; first += numLanes)
+    {
+        auto numGroupChannels = juce::jmin(numLanes, numChannels - first);
+
+        std::array<SampleType*, numLanes> channels{};
+
+        for (size_t ch = 0; ch < numGroupChannels; ++ch)
+            channels[ch] = block.getChannelPointer(first + ch);
+
+        auto* s1 = state1.data() + (first / numLanes) * (size_t) numBands;
+        auto* s2 = state2.data() + (first / numLanes) * (size_t) numBands;
+
+        //unused lanes stay at zero so they never produce denormals
+        alignas (Register::SIMDRegisterSize) SampleType frame[numLanes] = {};
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            for (size_t ch = 0; ch < numGroupChannels; ++ch)
+                frame[ch] = channels[ch][i];
+
+            auto x = Register::fromRawArray(frame);
+
+            //every lane runs the same bands, so the coefficients are scalars broadcast across the register
+            for (int band = 0; band < numActiveBands; ++band)
+            {
+                auto y = x * b0[(size_t) band] + s1[band];
+                s1[band] = x * b1[(size_t) band] - y * a1[(size_t) band] + s2[band];
+                s2[band] = x * b2[(size_t) band] - y * a2[(size_t) band];
+                x = y;
+            }
+
+            x.copyToRawArray(frame);
+
+            for (size_t ch = 0; ch < numGroupChannels; ++ch)
+                channels[ch][i] = frame[ch];
+        }
+    }
+}
+
+template class ParametricBands<float>;
+template class ParametricBands<double>;
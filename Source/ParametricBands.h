@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    ParametricBands.h
+
+    The extra peak, shelf and notch bands that sit next to the MonoChain, up
+    to maxParametricBands of them.
+
+    Everything is sized in prepare for a band count and a channel count, so
+    turning bands on and off or redesigning them never allocates. The
+    coefficients are kept structure of arrays style, one array per
+    coefficient, and the state one SIMDRegister per band and group of
+    channels, with a channel in each lane like SimdCascade. The bands that
+    are switched on are packed to the front of those arrays, so the
+    processing loop runs over exactly the active bands with no gaps or
+    bypass checks, and a band that is off costs nothing.
+
+    The arithmetic is the same transposed direct form II as IIR::Filter.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FilterCoefficients.h"
+
+template <typename SampleType>
+class ParametricBands
+{
+public:
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr size_t numLanes = Register::SIMDNumElements;
+
+    //message thread: sizes everything for a band count and the channels of the bus, every band starts off
+    void prepare(int numBands, int numChannels);
+
+    //clears the state of every band
+    void reset() noexcept;
+
+    int getNumBands() const noexcept { return numBands; }
+    int getNumActiveBands() const noexcept { return numActiveBands; }
+
+    //audio thread: gives a band new coefficients, or switches it off when isActive is false
+    //a band that comes on starts from silence, the others keep their state
+    void setBand(int band, const BiquadCoefficients& coefficients, bool isActive) noexcept;
+
+    //processes up to the prepared number of channels in place
+    void process(const juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+private:
+    //packs the active bands to the front of the arrays, carrying their state along
+    void compact() noexcept;
+
+    int numBands{ 0 };
+    size_t numGroups{ 0 };
+
+    //the designs of every band, active or not, in band order
+    std::vector<std::array<SampleType, 5>> bandCoefficients;
+
+    //one bit per band that is switched on
+    juce::uint32 activeBands{ 0 };
+    bool needsCompacting{ false };
+
+    //where each band sits in the packed arrays, -1 while it's off
+    std::vector<int> bandSlots, newBandSlots;
+    int numActiveBands{ 0 };
+
+    //the packed coefficients, numActiveBands of each are used
+    std::vector<SampleType> b0, b1, b2, a1, a2;
+
+    //the packed state, numBands per group of channels
+    std::vector<Register> state1, state2;
+    std::vector<Register> compactState1, compactState2;
+};
@@ -11,30 +11,104 @@
 
 //==============================================================================
 SimpleEQAudioProcessorEditor::SimpleEQAudioProcessorEditor (SimpleEQAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p),
+      analyzerComponent (p.getSpectrumAnalyzer()),
+      responseCurveComponent (p),
+      loadMeterComponent (p.getLoadMeter())
 {
+    addAndMakeVisible(analyzerComponent);
+    addAndMakeVisible(responseCurveComponent);
+
+    attachSlider(lowCutFreqSlider, "LowCut Freq");
+    attachSlider(peakFreqSlider, "Peak Freq");
+    attachSlider(peakGainSlider, "Peak Gain");
+    attachSlider(peakQualitySlider, "Peak Quality");
+    attachSlider(highCutFreqSlider, "HighCut Freq");
+
+    attachComboBox(lowCutSlopeBox, "LowCut Slope");
+    attachComboBox(highCutSlopeBox, "HighCut Slope");
+    attachComboBox(oversamplingBox, "Oversampling");
+
+    addAndMakeVisible(linearPhaseButton);
+    linearPhaseAttachment = std::make_unique<APVTS::ButtonAttachment>(audioProcessor.apvts, "Linear Phase", linearPhaseButton);
+
+    addAndMakeVisible(loadMeterComponent);
+
+    addLabel(lowCutFreqSlider, "LowCut");
+    addLabel(peakFreqSlider, "Peak Freq");
+    addLabel(peakGainSlider, "Peak Gain");
+    addLabel(peakQualitySlider, "Peak Q");
+    addLabel(highCutFreqSlider, "HighCut");
+    addLabel(oversamplingBox, "Oversampling");
+
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
-    setSize (400, 300);
+    setSize (640, 520);
 }
 
 SimpleEQAudioProcessorEditor::~SimpleEQAudioProcessorEditor()
 {
 }
 
+void SimpleEQAudioProcessorEditor::attachSlider(juce::Slider& slider, const juce::String& parameterID)
+{
+    addAndMakeVisible(slider);
+    sliderAttachments.push_back(std::make_unique<APVTS::SliderAttachment>(audioProcessor.apvts, parameterID, slider));
+}
+
+void SimpleEQAudioProcessorEditor::attachComboBox(juce::ComboBox& comboBox, const juce::String& parameterID)
+{
+    //the attachment selects an item by index, so the choices have to be there first
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.apvts.getParameter(parameterID)))
+        comboBox.addItemList(choice->choices, 1);
+
+    addAndMakeVisible(comboBox);
+    comboBoxAttachments.push_back(std::make_unique<APVTS::ComboBoxAttachment>(audioProcessor.apvts, parameterID, comboBox));
+}
+
+void SimpleEQAudioProcessorEditor::addLabel(juce::Component& component, const juce::String& text)
+{
+    auto* label = labels.add(std::make_unique<juce::Label>(juce::String(), text));
+    label->setJustificationType(juce::Justification::centred);
+    label->attachToComponent(&component, false);
+}
+
 //==============================================================================
 void SimpleEQAudioProcessorEditor::paint (juce::Graphics& g)
 {
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    g.setColour (juce::Colours::white);
-    g.setFont (juce::FontOptions (15.0f));
-    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
 }
 
 void SimpleEQAudioProcessorEditor::resized()
 {
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
+    //analyzer across the top, then a column per band with the processing options along the bottom
+    auto bounds = getLocalBounds().reduced(8);
+
+    analyzerComponent.setBounds(bounds.removeFromTop(juce::roundToInt(bounds.getHeight() * 0.45f)));
+    responseCurveComponent.setBounds(analyzerComponent.getBounds());
+    bounds.removeFromTop(24);
+
+    auto optionsArea = bounds.removeFromBottom(28);
+    optionsArea.removeFromLeft(100);
+    oversamplingBox.setBounds(optionsArea.removeFromLeft(100));
+    optionsArea.removeFromLeft(16);
+    linearPhaseButton.setBounds(optionsArea.removeFromLeft(120));
+    loadMeterComponent.setBounds(optionsArea.removeFromRight(240));
+    bounds.removeFromBottom(24);
+
+    auto lowCutArea = bounds.removeFromLeft(bounds.getWidth() / 3);
+    auto highCutArea = bounds.removeFromRight(bounds.getWidth() / 2);
+
+    lowCutSlopeBox.setBounds(lowCutArea.removeFromBottom(24).reduced(16, 0));
+    lowCutFreqSlider.setBounds(lowCutArea);
+
+    highCutSlopeBox.setBounds(highCutArea.removeFromBottom(24).reduced(16, 0));
+    highCutFreqSlider.setBounds(highCutArea);
+
+    peakFreqSlider.setBounds(bounds.removeFromTop(bounds.getHeight() / 2));
+    bounds.removeFromTop(20);
+
+    peakGainSlider.setBounds(bounds.removeFromLeft(bounds.getWidth() / 2));
+    peakQualitySlider.setBounds(bounds);
 }
@@ -10,6 +10,18 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "SpectrumAnalyzerComponent.h"
+#include "ResponseCurveComponent.h"
+#include "DspLoadMeterComponent.h"
+
+//rotary knob with the value underneath
+struct CustomRotarySlider : juce::Slider
+{
+    CustomRotarySlider() : juce::Slider(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag,
+                                        juce::Slider::TextEntryBoxPosition::TextBoxBelow)
+    {
+    }
+};
 
 //==============================================================================
 /**
@@ -29,5 +41,36 @@ private:
     // access the processor object that created it.
     SimpleEQAudioProcessor& audioProcessor;
 
+    //switches the processor's analyzer on for as long as the editor is open
+    SpectrumAnalyzerComponent analyzerComponent;
+
+    //drawn over the analyzer, only redrawn when a parameter moves
+    ResponseCurveComponent responseCurveComponent;
+
+    CustomRotarySlider peakFreqSlider,
+        peakGainSlider,
+        peakQualitySlider,
+        lowCutFreqSlider,
+        highCutFreqSlider;
+
+    juce::ComboBox lowCutSlopeBox, highCutSlopeBox, oversamplingBox;
+    juce::ToggleButton linearPhaseButton{ "Linear Phase" };
+
+    //how much of the audio thread's budget this instance takes, next to the processing options
+    DspLoadMeterComponent loadMeterComponent;
+
+    //a name above every control, owned here so the attachments below can be declared after the controls
+    juce::OwnedArray<juce::Label> labels;
+
+    //attachments keep the controls and the apvts in step, they are made once the combo boxes have their items
+    using APVTS = juce::AudioProcessorValueTreeState;
+    std::vector<std::unique_ptr<APVTS::SliderAttachment>> sliderAttachments;
+    std::vector<std::unique_ptr<APVTS::ComboBoxAttachment>> comboBoxAttachments;
+    std::unique_ptr<APVTS::ButtonAttachment> linearPhaseAttachment;
+
+    void attachSlider(juce::Slider& slider, const juce::String& parameterID);
+    void attachComboBox(juce::ComboBox& comboBox, const juce::String& parameterID);
+    void addLabel(juce::Component& component, const juce::String& text);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessorEditor)
 };
@@ -9,6 +9,37 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    //1 + a1 + a2 of a cut band's first section, below this the band moves to double in PrecisionMode::automatic
+    //and it has to come back above the second value to move back, so a slowly swept cut doesn't flip every block
+    constexpr double enterDoublePrecisionDistance = 3.0e-5;
+    constexpr double leaveDoublePrecisionDistance = 6.0e-5;
+
+    //copies a block into one of the other precision, both the same size
+    template <typename DestinationType, typename SourceType>
+    void copyConverting(const juce::dsp::AudioBlock<DestinationType>& destination,
+                        const juce::dsp::AudioBlock<SourceType>& source) noexcept
+    {
+        for (size_t ch = 0; ch < source.getNumChannels(); ++ch)
+        {
+            auto* input = source.getChannelPointer(ch);
+            auto* output = destination.getChannelPointer(ch);
+
+            for (size_t i = 0; i < source.getNumSamples(); ++i)
+                output[i] = static_cast<DestinationType>(input[i]);
+        }
+    }
+
+    //largest absolute sample, from the block's vectorised min and max scan
+    template <typename SampleType>
+    SampleType getPeakLevel(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        auto range = block.findMinAndMax();
+        return juce::jmax(-range.getStart(), range.getEnd());
+    }
+}
+
 //==============================================================================
 SimpleEQAudioProcessor::SimpleEQAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -16,16 +47,27 @@ SimpleEQAudioProcessor::SimpleEQAudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
                        )
 #endif
 {
+    //the audio thread can't post messages, so the message thread checks for a new mode's latency instead
+    startTimerHz(latencyPollsPerSecond);
 }
 
 SimpleEQAudioProcessor::~SimpleEQAudioProcessor()
 {
+    stopTimer();
+}
+
+void SimpleEQAudioProcessor::timerCallback()
+{
+    //only once the audio thread is running the new mode, so the host never compensates for one that isn't there yet
+    if (auto latency = activeModeLatency.load(); latency != getLatencySamples())
+        setLatencySamples(latency);
 }
 
 //==============================================================================
@@ -63,7 +105,11 @@ bool SimpleEQAudioProcessor::isMidiEffect() const
 
 double SimpleEQAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    //the filters ringing down to silenceThreshold, then whatever the oversamplers or the FIR still hold
+    auto ringSeconds = juce::jmin(maxTailSeconds, coefficientDesigner.getTailLengthSeconds() + parametricTailSeconds.load());
+    auto latencySeconds = getSampleRate() > 0 ? getLatencySamples() / getSampleRate() : 0.0;
+
+    return ringSeconds + latencySeconds;
 }
 
 int SimpleEQAudioProcessor::getNumPrograms()
@@ -91,43 +137,455 @@ void SimpleEQAudioProcessor::changeProgramName (int index, const juce::String& n
 }
 
 /* Edits */
-void SimpleEQAudioProcessor::updatePeakFilter(const ChainSettings& chainSettings)
+template <typename ChainType>
+void SimpleEQAudioProcessor::updatePeakFilter(ChainType& chain, const BiquadCoefficients& peakCoefficients)
 {
-    auto peakCoefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(getSampleRate(),
-        chainSettings.peakFreq,
-        chainSettings.peakQuality,
-        juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
-
     //coefficients is allocated on heap so we have to dereference it
     //functions needs an index to particular element in chain
     
     //same thing written below just written differently
-    //*leftChain.get<ChainPositions::Peak>().coefficients = *peakCoefficients;
-    //*rightChain.get<ChainPositions::Peak>().coefficients = *peakCoefficients;
+    //*chain.get<ChainPositions::Peak>().coefficients = *peakCoefficients;
     
-    updateCoefficients(leftChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+    updateCoefficients(chain.template get<ChainPositions::Peak>().coefficients, peakCoefficients);
+}
+
+template <typename CoefficientsPtr>
+void SimpleEQAudioProcessor::updateCoefficients(CoefficientsPtr& old, const BiquadCoefficients& replacements)
+{
+    //the storage was sized for a biquad in prepareCoefficientStorage, so this is a plain copy
+    jassert(old->coefficients.size() == (int) replacements.size());
+
+    auto* destination = old->getRawCoefficients();
 
+    for (size_t i = 0; i < replacements.size(); ++i)
+        destination[i] = static_cast<std::remove_pointer_t<decltype(destination)>>(replacements[i]);
 }
 
-void SimpleEQAudioProcessor::updateCoefficients(Coefficients& old, const Coefficients& replacements)
+//the cascade only swaps its processing loop when the slope actually changed
+template <typename ChainType>
+void SimpleEQAudioProcessor::updateLowCutFilters(ChainType& chain, const FilterCoefficientSet& coefficientSet)
 {
-    *old = *replacements;
+    auto& lowCut = chain.template get<ChainPositions::LowCut>();
+    lowCut.setCoefficients(coefficientSet.lowCut, coefficientSet.lowCutSlope);
 }
 
-void updateLowCutFilters(const ChainSettings& chainSettings)
+template <typename ChainType>
+void SimpleEQAudioProcessor::updateHighCutFilters(ChainType& chain, const FilterCoefficientSet& coefficientSet)
 {
+    auto& highCut = chain.template get<ChainPositions::HighCut>();
+    highCut.setCoefficients(coefficientSet.highCut, coefficientSet.highCutSlope);
+}
+
+void SimpleEQAudioProcessor::applyToChannel(size_t ch, const FilterCoefficientSet& coefficientSet, int bands)
+{
+    //double buffers only ever go through the double chains
+    if (isUsingDoublePrecision())
+    {
+        if (bands & ParameterCache::lowCutBand)
+            updateLowCutFilters(doubleChains[ch], coefficientSet);
+
+        if (bands & ParameterCache::peakBand)
+            updatePeakFilter(doubleChains[ch], coefficientSet.peak);
+
+        if (bands & ParameterCache::highCutBand)
+            updateHighCutFilters(doubleChains[ch], coefficientSet);
 
+        return;
+    }
+
+    auto& chain = chains[ch];
+    auto& doubleChain = doubleChains[ch];
+    auto& cascade = cascades[ch / SimdCascade::numLanes];
+    auto lane = ch % SimdCascade::numLanes;
+
+    auto doubleBands = getDoublePrecisionBands(coefficientSet, bands, channelDoubleBands[ch]);
+
+    //a band moving between float and double starts from silence in the filters it moves to
+    if (auto movedBands = doubleBands ^ channelDoubleBands[ch]; movedBands != 0)
+    {
+        if (movedBands & ParameterCache::lowCutBand)
+        {
+            chain.get<ChainPositions::LowCut>().reset();
+            doubleChain.get<ChainPositions::LowCut>().reset();
+        }
+
+        if (movedBands & ParameterCache::highCutBand)
+        {
+            chain.get<ChainPositions::HighCut>().reset();
+            doubleChain.get<ChainPositions::HighCut>().reset();
+        }
+
+        cascade.resetLane(lane);
+
+        channelDoubleBands[ch] = doubleBands;
+        hasDoublePrecisionBands = std::any_of(channelDoubleBands.begin(), channelDoubleBands.end(),
+                                              [](int channelBands) { return channelBands != 0; });
+    }
+
+    //the float filters stay up to date either way, so a band can move back without waiting for a redesign
+    if (bands & ParameterCache::lowCutBand)
+        updateLowCutFilters(chain, coefficientSet);
+
+    if (bands & ParameterCache::peakBand)
+        updatePeakFilter(chain, coefficientSet.peak);
+
+    if (bands & ParameterCache::highCutBand)
+        updateHighCutFilters(chain, coefficientSet);
+
+    //the float paths leave out the bands that run in double
+    chain.setBypassed<ChainPositions::LowCut>((doubleBands & ParameterCache::lowCutBand) != 0);
+    chain.setBypassed<ChainPositions::HighCut>((doubleBands & ParameterCache::highCutBand) != 0);
+
+    //keep the SIMD path in step so switching paths never picks up old coefficients
+    cascade.setCoefficients(lane, coefficientSet, doubleBands);
+
+    if (bands & doubleBands & ParameterCache::lowCutBand)
+        updateLowCutFilters(doubleChain, coefficientSet);
+
+    if (bands & doubleBands & ParameterCache::highCutBand)
+        updateHighCutFilters(doubleChain, coefficientSet);
 }
 
-void updateHighCUtFilters(const ChainSettings& chainSettings)
+void SimpleEQAudioProcessor::updateFilters(const ChannelGroupCoefficients& groupCoefficients)
 {
+    for (size_t ch = 0; ch < channelGroups.size(); ++ch)
+    {
+        const auto& designedSet = groupCoefficients[(size_t) channelGroups[ch]];
+        const auto& coefficientSet = (designedSet.isLinked && isUsingSmoothedSet) ? smoothedSet : designedSet;
 
+        applyToChannel(ch, coefficientSet, ParameterCache::allBands);
+    }
 }
 
-void updateFilters()
+void SimpleEQAudioProcessor::updateSmoothedFilters(int bands)
 {
-    
+    //same allocation free designs the background designer uses, only for the bands that moved
+    auto chainSettings = smoother.getCurrentSettings();
+    auto sampleRate = getProcessingSampleRate();
+
+    if (bands & ParameterCache::lowCutBand)
+    {
+        smoothedSet.lowCut = makeLowCutCoefficients(chainSettings, sampleRate);
+        smoothedSet.lowCutSlope = chainSettings.lowCutSlope;
+    }
+
+    if (bands & ParameterCache::peakBand)
+        smoothedSet.peak = makePeakCoefficients(chainSettings, sampleRate);
+
+    if (bands & ParameterCache::highCutBand)
+    {
+        smoothedSet.highCut = makeHighCutCoefficients(chainSettings, sampleRate);
+        smoothedSet.highCutSlope = chainSettings.highCutSlope;
+    }
+
+    for (size_t ch = 0; ch < channelGroups.size(); ++ch)
+        if (designedCoefficients[(size_t) channelGroups[ch]].isLinked)
+            applyToChannel(ch, smoothedSet, bands);
+}
+
+void SimpleEQAudioProcessor::updateSmoothing()
+{
+    smoother.setTargetSettings(parameterCache.getChainSettings());
+
+    auto linkedSet = std::find_if(designedCoefficients.begin(), designedCoefficients.end(),
+                                  [](const FilterCoefficientSet& set) { return set.isLinked; });
+
+    //once the ramps stand still on the settings the designer's set was made from, its set is the same as ours
+    if (linkedSet == designedCoefficients.end()
+        || (! smoother.isSmoothing() && linkedSet->settings == smoother.getCurrentSettings()))
+    {
+        releaseSmoothedSet();
+        return;
+    }
+
+    //a ramp is starting, or the designer hasn't caught up with where one ended,
+    //the smoothed set starts from where the ramps stand, which is what the filters have now
+    if (! isUsingSmoothedSet)
+    {
+        isUsingSmoothedSet = true;
+        updateSmoothedFilters(ParameterCache::allBands);
+    }
+}
+
+void SimpleEQAudioProcessor::restartSmoothing()
+{
+    if (! isSmoothingActive())
+    {
+        releaseSmoothedSet();
+        return;
+    }
+
+    smoother.setCurrentAndTargetSettings(parameterCache.getChainSettings());
+
+    isUsingSmoothedSet = true;
+    updateSmoothedFilters(ParameterCache::allBands);
+    updateSmoothing();
+}
+
+void SimpleEQAudioProcessor::releaseSmoothedSet()
+{
+    if (isUsingSmoothedSet)
+    {
+        isUsingSmoothedSet = false;
+        updateFilters(designedCoefficients);
+    }
+}
+
+template <typename SampleType>
+void SimpleEQAudioProcessor::updateDynamicPeak(const juce::dsp::AudioBlock<SampleType>& detectorBlock, const DynamicSettings& dynamicSettings)
+{
+    //the dynamic gain goes on top of the peak the linked groups would have anyway, smoothed or straight from the parameters
+    auto chainSettings = isUsingSmoothedSet ? smoother.getCurrentSettings() : parameterCache.getChainSettings();
+
+    dynamicPeak.setDetectorBand(chainSettings.peakFreq, chainSettings.peakQuality);
+    auto gainOffset = dynamicPeak.process(detectorBlock, dynamicSettings);
+
+    //frequency and Q hardly ever move while the gain does, so this is usually just the gain update
+    dynamicPeakDesign.setFrequencyAndQuality(chainSettings.peakFreq, chainSettings.peakQuality, getProcessingSampleRate());
+    auto peakCoefficients = dynamicPeakDesign.makeCoefficients(chainSettings.peakGainInDecibels + gainOffset);
+
+    for (size_t ch = 0; ch < channelGroups.size(); ++ch)
+        if (designedCoefficients[(size_t) channelGroups[ch]].isLinked)
+            applyPeakToChannel(ch, peakCoefficients);
+}
+
+void SimpleEQAudioProcessor::applyPeakToChannel(size_t ch, const BiquadCoefficients& peakCoefficients)
+{
+    if (isUsingDoublePrecision())
+    {
+        updatePeakFilter(doubleChains[ch], peakCoefficients);
+        return;
+    }
+
+    //the peak never runs in double on float buffers, so only the float paths need it
+    updatePeakFilter(chains[ch], peakCoefficients);
+    cascades[ch / SimdCascade::numLanes].setPeakCoefficients(ch % SimdCascade::numLanes, peakCoefficients);
+}
+
+void SimpleEQAudioProcessor::setIdle(bool shouldBeIdle)
+{
+    isIdleActive = shouldBeIdle;
+
+    //everything left in the filters is below silenceThreshold, so clearing it now is inaudible and they wake up from exact silence
+    if (shouldBeIdle)
+    {
+        resetFilters();
+        resetActiveOversampler();
+        linearPhaseEngine.reset();
+        dynamicPeak.reset();
+        return;
+    }
+
+    //the ramps stood still while nothing was processed, they start from where the parameters are now
+    restartSmoothing();
+
+    if (! isLinearPhaseActive && activeFilterEngine == FilterEngine::stateVariable)
+        updateSvfTargets(true);
+}
+
+void SimpleEQAudioProcessor::setDynamicActive(bool shouldBeActive)
+{
+    isDynamicActive = shouldBeActive;
+
+    //the detector starts from silence, and a peak left with a dynamic gain goes back to the designed one
+    dynamicPeak.reset();
+
+    if (! isDynamicActive)
+        updateFilters(designedCoefficients);
+}
+
+int SimpleEQAudioProcessor::getDoublePrecisionBands(const FilterCoefficientSet& coefficientSet, int bands, int currentDoubleBands) const noexcept
+{
+    switch (activePrecisionMode)
+    {
+        case PrecisionMode::singlePrecision:    return 0;
+        case PrecisionMode::doublePrecision:    return ParameterCache::lowCutBand | ParameterCache::highCutBand;
+        case PrecisionMode::automatic:          break;
+    }
+
+    auto doubleBands = currentDoubleBands;
+
+    auto check = [&](int band, const CutCoefficients& cut)
+    {
+        if ((bands & band) == 0)
+            return;
+
+        //1 + a1 + a2 is about w0^2 for a Butterworth section, how far its poles are from z = 1
+        //below about 3e-5 the float response is off by more than -70 dB, a 40 Hz cut at 48 kHz
+        auto poleDistance = 1.0 + cut[0][3] + cut[0][4];
+        auto threshold = (currentDoubleBands & band) != 0 ? leaveDoublePrecisionDistance : enterDoublePrecisionDistance;
+
+        if (poleDistance < threshold)
+            doubleBands |= band;
+        else
+            doubleBands &= ~band;
+    };
+
+    check(ParameterCache::lowCutBand, coefficientSet.lowCut);
+    check(ParameterCache::highCutBand, coefficientSet.highCut);
+
+    return doubleBands;
+}
+
+void SimpleEQAudioProcessor::setActivePrecisionMode(PrecisionMode mode)
+{
+    activePrecisionMode = mode;
+
+    std::fill(channelDoubleBands.begin(), channelDoubleBands.end(), 0);
+    hasDoublePrecisionBands = false;
+
+    resetFilters();
+    updateFilters(designedCoefficients);
+}
+
+void SimpleEQAudioProcessor::resetFilters()
+{
+    for (auto& chain : chains)
+        chain.reset();
+
+    for (auto& chain : doubleChains)
+        chain.reset();
+
+    for (auto& chain : svfChains)
+        chain.reset();
+
+    for (auto& chain : doubleSvfChains)
+        chain.reset();
+
+    for (auto& cascade : cascades)
+        cascade.reset();
+
+    parametricBands.reset();
+    doubleParametricBands.reset();
+}
+
+void SimpleEQAudioProcessor::updateParametricBands(juce::uint32 bands)
+{
+    //the linear phase engine runs at the host rate, so the bands after it do too
+    auto sampleRate = isLinearPhaseActive ? getSampleRate() : getProcessingSampleRate();
+    auto numBands = isUsingDoublePrecision() ? doubleParametricBands.getNumBands() : parametricBands.getNumBands();
+
+    //only the bands that changed are designed, the audio thread never redesigns the ones that are off or still
+    for (int band = 0; band < numBands; ++band)
+    {
+        if ((bands & ((juce::uint32) 1 << band)) == 0)
+            continue;
+
+        auto settings = parameterCache.getBandSettings(band);
+        auto isActive = settings.type != BandType::off;
+
+        auto coefficients = makeBandCoefficients(settings, sampleRate);
+        parametricBandDecayLengths[(size_t) band] = isActive ? getDecayLength(coefficients, silenceThreshold) : 0.0;
+
+        if (isUsingDoublePrecision())
+            doubleParametricBands.setBand(band, coefficients, isActive);
+        else
+            parametricBands.setBand(band, coefficients, isActive);
+    }
+
+    //the bands run one after the other, so their tails add up like the sections of a cut band
+    auto decayLength = std::accumulate(parametricBandDecayLengths.begin(), parametricBandDecayLengths.begin() + numBands, 0.0);
+    parametricTailSeconds = decayLength / sampleRate;
+}
+
+void SimpleEQAudioProcessor::updateSvfTargets(bool shouldJump)
+{
+    //the linked groups read the parameters straight from the cache, they don't wait for the designer
+    auto linkedSettings = parameterCache.getChainSettings();
+    auto rampLengthSeconds = activeSubBlockSize > 0 ? smoothingTimeSeconds : 0.0;
+
+    for (size_t ch = 0; ch < channelGroups.size(); ++ch)
+    {
+        const auto& designedSet = designedCoefficients[(size_t) channelGroups[ch]];
+        const auto& settings = designedSet.isLinked ? linkedSettings : designedSet.settings;
+
+        if (isUsingDoublePrecision())
+            setSvfTargets(doubleSvfChains[ch], settings, rampLengthSeconds, shouldJump);
+        else
+            setSvfTargets(svfChains[ch], settings, rampLengthSeconds, shouldJump);
+    }
+}
+
+template <typename SampleType>
+void SimpleEQAudioProcessor::setSvfTargets(SvfChain<SampleType>& chain, const ChainSettings& settings, double rampLengthSeconds, bool shouldJump)
+{
+    auto& lowCut = chain.template get<ChainPositions::LowCut>();
+    auto& peak = chain.template get<ChainPositions::Peak>();
+    auto& highCut = chain.template get<ChainPositions::HighCut>();
+
+    lowCut.setRampLength(rampLengthSeconds);
+    peak.setRampLength(rampLengthSeconds);
+    highCut.setRampLength(rampLengthSeconds);
+
+    auto lowCutFreq = static_cast<SampleType>(settings.lowCutFreq);
+    auto highCutFreq = static_cast<SampleType>(settings.highCutFreq);
+    auto peakFreq = static_cast<SampleType>(settings.peakFreq);
+    auto peakQuality = static_cast<SampleType>(settings.peakQuality);
+    auto peakGain = static_cast<SampleType>(settings.peakGainInDecibels);
+
+    if (shouldJump)
+    {
+        lowCut.setCurrentAndTarget(lowCutFreq, settings.lowCutSlope);
+        peak.setCurrentAndTarget(peakFreq, peakQuality, peakGain);
+        highCut.setCurrentAndTarget(highCutFreq, settings.highCutSlope);
+    }
+    else
+    {
+        lowCut.setTarget(lowCutFreq, settings.lowCutSlope);
+        peak.setTarget(peakFreq, peakQuality, peakGain);
+        highCut.setTarget(highCutFreq, settings.highCutSlope);
+    }
+}
+
+void SimpleEQAudioProcessor::prepareSvfChains()
+{
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = getProcessingSampleRate();
+    spec.maximumBlockSize = (juce::uint32) oversamplingBlockSize << activeOversamplingOrder;
+    spec.numChannels = 1;
+
+    //nothing is allocated, the filters only pick up the rate and start from silence
+    for (auto& chain : svfChains)
+        chain.prepare(spec);
+
+    for (auto& chain : doubleSvfChains)
+        chain.prepare(spec);
+}
+
+void SimpleEQAudioProcessor::setActiveFilterEngine(FilterEngine engine)
+{
+    activeFilterEngine = engine;
+
+    resetFilters();
+
+    if (activeFilterEngine == FilterEngine::stateVariable)
+        updateSvfTargets(true);
+
+    //the smoother stood still while the state variable filters ramped themselves
+    restartSmoothing();
+}
+
+template <typename SampleType>
+void SimpleEQAudioProcessor::prepareCoefficientStorage(MonoChain<SampleType>& chain)
+{
+    //b0, b1, b2, a0, a1, a2 of a pass-through biquad, the cut cascades hold their coefficients themselves
+    chain.template get<ChainPositions::Peak>().coefficients
+        = new juce::dsp::IIR::Coefficients<SampleType>(SampleType(1), SampleType(0), SampleType(0),
+                                                       SampleType(1), SampleType(0), SampleType(0));
+}
+
+template <typename SampleType>
+void SimpleEQAudioProcessor::prepareOversamplers(size_t numChannels)
+{
+    for (int order = 1; order <= maxOversamplingOrder; ++order)
+    {
+        auto& oversampler = getOversamplers<SampleType>()[(size_t) order - 1];
+
+        oversampler = std::make_unique<juce::dsp::Oversampling<SampleType>>(numChannels, (size_t) order,
+                                                                           juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR);
+        oversampler->initProcessing(oversamplingBlockSize);
+        oversamplingLatencies[(size_t) order] = juce::roundToInt(oversampler->getLatencyInSamples());
+    }
 }
 
 //==============================================================================
@@ -135,53 +593,134 @@ void SimpleEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
 {
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
+
+    //the designer's worker reads the latencies, keep it out of the way while they're rebuilt
+    coefficientDesigner.release();
+
     //process spec obj prepares filter by passing spec ob to chain which passes it to each link in chain 
     juce::dsp::ProcessSpec spec;
 
-    spec.maximumBlockSize = samplesPerBlock;
+    //oversampled blocks are up to 2^maxOversamplingOrder times longer
+    spec.maximumBlockSize = (juce::uint32) samplesPerBlock << maxOversamplingOrder;
     spec.numChannels = 1; //mono chains can only handle one channel
 
     spec.sampleRate = sampleRate;
-    
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
 
-    //we have our settings so we can produce coefficients using static helper functions
-    auto chainSettings = getChainSettings(apvts);
-    
-    updatePeakFilter(chainSettings);
+    //one chain per channel of the main bus, and enough SIMD cascades to give every channel a lane
+    //the sidechain only feeds the detector, it never goes through the filters
+    auto numChannels = (size_t) juce::jmax(getMainBusNumInputChannels(), getMainBusNumOutputChannels());
 
-    //peak filter will make audible changes if gain parameter is not 0 
-    //changes to slider wont do anything since we're not updating filter with new coefficients (modify processBlock)
+    chains = std::vector<MonoChain<float>>(numChannels);
+    doubleChains = std::vector<MonoChain<double>>(numChannels);
+    cascades = std::vector<SimdCascade>((numChannels + SimdCascade::numLanes - 1) / SimdCascade::numLanes);
+    channelGroups = getChannelGroups(getChannelLayoutOfBus(false, 0), (int) numChannels);
 
-    //high pass attenuates lower frequencies 
-    auto lowCutCoefficients = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq,
-                                                                                                    sampleRate,
-                                                                                                    2 * (chainSettings.lowCutSlope + 1));   
-    auto& leftLowCut = leftChain.get<ChainPositions::LowCut>();
+    for (auto& chain : chains)
+    {
+        //the filters size their state from the coefficients, so the storage has to exist before prepare
+        prepareCoefficientStorage(chain);
+        chain.prepare(spec);
+    }
 
-    updateCutFilter(leftLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
+    for (auto& chain : doubleChains)
+    {
+        prepareCoefficientStorage(chain);
+        chain.prepare(spec);
+    }
 
+    //the state variable chains are given their rate in setActiveOversamplingOrder below
+    svfChains = std::vector<SvfChain<float>>(numChannels);
+    doubleSvfChains = std::vector<SvfChain<double>>(numChannels);
 
+    auto setTypes = [](auto& chain)
+    {
+        using CutType = std::remove_reference_t<decltype(chain.template get<ChainPositions::LowCut>())>;
 
-    auto& rightLowCut = rightChain.get<ChainPositions::LowCut>();
-    updateCutFilter(rightLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
+        chain.template get<ChainPositions::LowCut>().setType(CutType::Type::lowCut);
+        chain.template get<ChainPositions::HighCut>().setType(CutType::Type::highCut);
+    };
 
-    //low pass attenuates higher frequencies 
-    auto highCutCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq,
-                                                                                                        sampleRate,
-                                                                                                        2 * (chainSettings.highCutSlope + 1));
-    auto& leftHighCut = leftChain.get<ChainPositions::HighCut>();
-    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.highCutSlope);
+    std::for_each(svfChains.begin(), svfChains.end(), setTypes);
+    std::for_each(doubleSvfChains.begin(), doubleSvfChains.end(), setTypes);
 
-    auto& rightHighCut = rightChain.get<ChainPositions::HighCut>();
-    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.highCutSlope);
+    //the parametric bands are designed for their rate in setActiveOversamplingOrder below
+    auto numBands = numParametricBands.load();
+    parametricBands.prepare(isUsingDoublePrecision() ? 0 : numBands, (int) numChannels);
+    doubleParametricBands.prepare(isUsingDoublePrecision() ? numBands : 0, (int) numChannels);
+
+    activeFilterEngine = filterEngine.load();
+
+    //which bands run in double is worked out again from the designed sets below
+    activePrecisionMode = precisionMode.load();
+    channelDoubleBands.assign(numChannels, 0);
+    hasDoublePrecisionBands = false;
+    doublePrecisionBuffer.assign((size_t) spec.maximumBlockSize, 0.0);
+
+    //every factor is ready up front, the parameter can change while playing
+    //only the precision the host asked for is built, the other set stays empty
+    oversamplingBlockSize = (size_t) samplesPerBlock;
+
+    if (isUsingDoublePrecision())
+    {
+        prepareOversamplers<double>(numChannels);
+        oversamplers = {};
+
+        //the FIR engine is float, double blocks are converted through this
+        linearPhaseBuffer.setSize((int) numChannels, samplesPerBlock);
+    }
+    else
+    {
+        prepareOversamplers<float>(numChannels);
+        doubleOversamplers = {};
+        linearPhaseBuffer.setSize(0, 0);
+    }
+
+    linearPhaseEngine.prepare(LinearPhaseSpec::forSampleRate(sampleRate), channelGroups);
+    linearPhaseLatency = linearPhaseEngine.getLatencySamples();
+
+    //the designer works out every band for the new sample rate before it returns
+    coefficientDesigner.prepare(sampleRate);
+
+    if (auto* groupCoefficients = coefficientDesigner.acquireCoefficients())
+        designedCoefficients = *groupCoefficients;
+
+    //start from the designed coefficients, processBlock hands the linked groups to the smoother if it is on
+    activeSubBlockSize = 0;
+    isUsingSmoothedSet = false;
+    setActiveOversamplingOrder(designedCoefficients.front().oversamplingOrder);
+    setLinearPhaseActive(designedCoefficients.front().isLinearPhase);
+    updateFilters(designedCoefficients);
+    updateSvfTargets(true);
+
+    if (isLinearPhaseActive)
+        if (auto* kernels = coefficientDesigner.acquireKernels())
+            linearPhaseEngine.setKernels(*kernels);
+
+    activeModeLatency.store(getModeLatency(activeOversamplingOrder, isLinearPhaseActive));
+    setLatencySamples(activeModeLatency.load());
+
+    smoother.prepare(sampleRate, smoothingTimeSeconds, parameterCache.getChainSettings());
+
+    spectrumAnalyzer.prepare(sampleRate);
+
+    dynamicPeak.prepare(sampleRate);
+    isDynamicActive = false;
+
+    loadMeter.prepare(sampleRate);
+
+    isIdleActive = false;
+    numSilentSamples = 0;
+
+    //peak filter will make audible changes if gain parameter is not 0 
+    //after this the designer only redesigns the bands the parameter cache flags as changed
 }
 
 void SimpleEQAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    coefficientDesigner.release();
+    spectrumAnalyzer.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -192,11 +731,15 @@ bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     return true;
   #else
     // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Every channel gets its own chain, so any layout up to maxNumChannels works,
+    // from mono and stereo to surround and ambisonic buses.
+    auto mainOutput = layouts.getMainOutputChannelSet();
+
+    if (mainOutput.isDisabled() || mainOutput.size() > maxNumChannels)
+        return false;
+
+    // The sidechain is summed into one detector, so it can be off, mono or stereo.
+    if (layouts.inputBuses.size() > 1 && layouts.getChannelSet(true, 1).size() > 2)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -209,14 +752,30 @@ bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
   #endif
 }
 #endif
+void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    processBuffer(buffer);
+}
+
+void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    processBuffer(buffer);
+}
+
 //processor chain requires processing context to be passed into it to run audio through links in chain
 //processor context needs audio block instance
 //process Block is called by host and is given a buffer which has any number of channels
 //we have to extract left and right channels from buffer (channels 0 and 1)
 
-void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+template <typename SampleType>
+void SimpleEQAudioProcessor::processBuffer(juce::AudioBuffer<SampleType>& buffer)
 {
+    //with SIMPLEEQ_RT_SAFETY_CHECKS on, any allocation or lock from here on is reported
+    RealtimeSafety::ScopedAudioThread audioThread;
     juce::ScopedNoDenormals noDenormals;
+
+    //a few counter reads per block, everything the stages below don't claim counts as processing
+    DspLoadMeter::ScopedBlock timedBlock(loadMeter, buffer.getNumSamples());
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -231,48 +790,368 @@ void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    //we have our settings so we can produce coefficients using static helper functions
-    //update filter with new coefficients 
-    auto chainSettings = getChainSettings(apvts);
+    {
+        DspLoadMeter::ScopedStage stage(loadMeter, DspLoadMeter::Stage::coefficientCopy);
+
+        //smoothing switched on or off since the last block
+        auto subBlockSize = smoothingSubBlockSize.load();
+
+        if (subBlockSize != activeSubBlockSize)
+        {
+            auto wasSmoothing = activeSubBlockSize > 0;
+            activeSubBlockSize = subBlockSize;
+
+            //the smoother picks up from the parameters, switched off the linked groups go back to the designer's sets
+            if (activeSubBlockSize == 0 || ! wasSmoothing)
+                restartSmoothing();
+        }
+
+        //the designer publishes a new set whenever a band changed, picking it up is just a pointer swap
+        //the set is copied into storage the filters already own, so the heap isn't touched here
+        if (auto* groupCoefficients = coefficientDesigner.acquireCoefficients())
+        {
+            designedCoefficients = *groupCoefficients;
+
+            //the sets were designed for a different rate, switch to it before they're applied
+            if (designedCoefficients.front().oversamplingOrder != activeOversamplingOrder)
+                setActiveOversamplingOrder(designedCoefficients.front().oversamplingOrder);
+
+            if (designedCoefficients.front().isLinearPhase != isLinearPhaseActive)
+                setLinearPhaseActive(designedCoefficients.front().isLinearPhase);
+
+            //acknowledges the mode, timerCallback passes its latency on to the host
+            activeModeLatency.store(getModeLatency(activeOversamplingOrder, isLinearPhaseActive), std::memory_order_relaxed);
+
+            updateFilters(designedCoefficients);
+        }
+
+        //the precision mode changed since the last block, every band is sorted again
+        if (auto mode = precisionMode.load(); mode != activePrecisionMode)
+            setActivePrecisionMode(mode);
+
+        if (auto engine = filterEngine.load(); engine != activeFilterEngine)
+            setActiveFilterEngine(engine);
+    }
 
-    updatePeakFilter(chainSettings);
+    DynamicSettings dynamicSettings;
+    juce::uint32 dirtyParametricBands = 0;
 
-    auto cutCoefficients = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq,
-        getSampleRate(),
-        2 * (chainSettings.lowCutSlope + 1));
+    {
+        DspLoadMeter::ScopedStage stage(loadMeter, DspLoadMeter::Stage::parameterFetch);
 
-    auto& leftLowCut = leftChain.get<ChainPositions::LowCut>();
-    updateCutFilter(leftLowCut, cutCoefficients, chainSettings.lowCutSlope);
+        dynamicSettings = parameterCache.getDynamicSettings();
+        dirtyParametricBands = parameterCache.consumeDirtyParametricBands();
 
+        //the state variable filters take the parameters as they are and ramp to them sample by sample
+        if (activeFilterEngine == FilterEngine::stateVariable && ! isLinearPhaseActive)
+            updateSvfTargets(false);
+    }
 
-    auto& rightLowCut = rightChain.get<ChainPositions::LowCut>();
-    updateCutFilter(rightLowCut, cutCoefficients, chainSettings.lowCutSlope);
+    {
+        DspLoadMeter::ScopedStage stage(loadMeter, DspLoadMeter::Stage::coefficientDesign);
 
-    //low pass attenuates higher frequencies 
-    auto highCutCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq,
-        getSampleRate(),
-        2 * (chainSettings.highCutSlope + 1));
+        //the dynamic peak needs the biquads' sub-block updates, the other modes keep the peak where it's designed
+        if (auto shouldBeDynamic = dynamicSettings.isEnabled && activeFilterEngine == FilterEngine::biquad && ! isLinearPhaseActive;
+            shouldBeDynamic != isDynamicActive)
+            setDynamicActive(shouldBeDynamic);
 
-    auto& leftHighCut = leftChain.get<ChainPositions::HighCut>();
-    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.highCutSlope);
+        //the parametric bands are cheap enough to design here, and only the ones whose parameters moved are
+        if (dirtyParametricBands != 0)
+            updateParametricBands(dirtyParametricBands);
 
-    auto& rightHighCut = rightChain.get<ChainPositions::HighCut>();
-    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.highCutSlope);
+        //the linked groups only run a set designed here while the smoother is ramping
+        if (isSmoothingActive())
+            updateSmoothing();
+    }
 
     //create audio block which wraps buffer
-    juce::dsp::AudioBlock<float> block(buffer);
+    juce::dsp::AudioBlock<SampleType> block(buffer);
+
+    //a mono bus only has channel 0, so never go past the channels the buffer and the pool both have
+    auto numChannels = juce::jmin(block.getNumChannels(), chains.size());
+    auto channelBlock = block.getSubsetChannelBlock(0, numChannels);
+
+    //switching paths starts the other one from silence rather than from stale state
+    auto shouldUseSimd = useSimdProcessing.load();
+
+    if (shouldUseSimd != isSimdPathActive)
+    {
+        isSimdPathActive = shouldUseSimd;
+        resetFilters();
+    }
+
+    //the detector listens to the sidechain when it's asked to and the host connected one, otherwise to the input
+    auto detectorBlock = channelBlock;
+
+    if (auto* sidechain = getBus(true, 1); dynamicSettings.useSidechain && sidechain != nullptr && sidechain->isEnabled())
+        detectorBlock = block.getSubsetChannelBlock((size_t) getChannelIndexInProcessBlockBuffer(true, 1, 0),
+                                                    (size_t) sidechain->getNumberOfChannels());
+
+    //any sample above the threshold wakes the filters up again, they were cleared when they went idle
+    auto isInputSilent = useIdleDetection.load() && getPeakLevel(channelBlock) < static_cast<SampleType>(silenceThreshold);
+
+    if (! isInputSilent)
+    {
+        numSilentSamples = 0;
+
+        if (isIdleActive.load(std::memory_order_relaxed))
+            setIdle(false);
+    }
+
+    //only a copy into the analyzer's FIFO, and only while the editor is showing it
+    spectrumAnalyzer.pushPre(channelBlock);
+
+    //while idle the input, already below the threshold, goes out as it came in
+    if (! isIdleActive.load(std::memory_order_relaxed))
+    {
+        if (isLinearPhaseActive)
+            processLinearPhase(channelBlock);
+        else if (isDynamicActive || isUsingSmoothedSet)
+            processSubBlocks(channelBlock, detectorBlock, dynamicSettings);
+        else
+            processOversampled(channelBlock);
+
+        //the tail is an estimate from the poles, the output has to be silent too, which catches a big low boost ringing longer
+        if (isInputSilent)
+        {
+            numSilentSamples += (juce::int64) channelBlock.getNumSamples();
+
+            if ((double) numSilentSamples >= getTailLengthSeconds() * getSampleRate()
+                && getPeakLevel(channelBlock) < static_cast<SampleType>(silenceThreshold))
+                setIdle(true);
+        }
+    }
+
+    spectrumAnalyzer.pushPost(channelBlock);
+}
+
+template <typename SampleType>
+void SimpleEQAudioProcessor::processSubBlocks(const juce::dsp::AudioBlock<SampleType>& block,
+                                              const juce::dsp::AudioBlock<SampleType>& detectorBlock,
+                                              const DynamicSettings& dynamicSettings)
+{
+    //ramp the parameters in sub-block steps, only the bands that are still moving get redesigned
+    auto isSmoothing = isUsingSmoothedSet;
+    auto subBlockSize = (size_t) (isSmoothing ? activeSubBlockSize : dynamicSubBlockSize);
+
+    auto numSamples = block.getNumSamples();
+
+    for (size_t start = 0; start < numSamples; start += subBlockSize)
+    {
+        auto length = juce::jmin(subBlockSize, numSamples - start);
+
+        //only timed when something is redesigned, a counter read per sub-block would cost more than it tells
+        if (isSmoothing)
+            if (auto bands = smoother.advance((int) length); bands != 0)
+            {
+                DspLoadMeter::ScopedStage stage(loadMeter, DspLoadMeter::Stage::coefficientDesign);
+                updateSmoothedFilters(bands);
+            }
+
+        //the detector hears the sub-block before the filters change it, and the peak moves after any redesign above
+        if (isDynamicActive)
+            updateDynamicPeak(detectorBlock.getSubBlock(start, length), dynamicSettings);
+
+        processOversampled(block.getSubBlock(start, length));
+    }
+}
+
+template <typename SampleType>
+void SimpleEQAudioProcessor::processOversampled(const juce::dsp::AudioBlock<SampleType>& block)
+{
+    if (activeOversamplingOrder == 0)
+    {
+        processChannels(block);
+        return;
+    }
+
+    auto& oversampler = *getOversamplers<SampleType>()[(size_t) activeOversamplingOrder - 1];
+    auto numSamples = block.getNumSamples();
+
+    //the oversampler's buffers only hold the block size prepareToPlay was given
+    for (size_t start = 0; start < numSamples; start += oversamplingBlockSize)
+    {
+        auto subBlock = block.getSubBlock(start, juce::jmin(oversamplingBlockSize, numSamples - start));
+
+        //the oversampled block has a channel for every chain, only the ones in use are processed
+        auto oversampledBlock = oversampler.processSamplesUp(subBlock);
+        processChannels(oversampledBlock.getSubsetChannelBlock(0, subBlock.getNumChannels()));
+
+        oversampler.processSamplesDown(subBlock);
+    }
+}
+
+void SimpleEQAudioProcessor::processLinearPhase(const juce::dsp::AudioBlock<float>& block)
+{
+    //a kernel is only taken once the last crossfade has run, until then the designer holds on to the newest one
+    //and the two sets the engine points at are left alone
+    if (linearPhaseEngine.isReadyForKernels())
+        if (auto* kernels = coefficientDesigner.acquireKernels())
+            linearPhaseEngine.setKernels(*kernels);
+
+    linearPhaseEngine.process(block);
+
+    //the parametric bands stay minimum phase, they're not part of the kernels
+    parametricBands.process(block);
+}
+
+void SimpleEQAudioProcessor::processLinearPhase(const juce::dsp::AudioBlock<double>& block)
+{
+    auto numSamples = block.getNumSamples();
+    auto bufferSize = (size_t) linearPhaseBuffer.getNumSamples();
+
+    for (size_t start = 0; start < numSamples; start += bufferSize)
+    {
+        auto subBlock = block.getSubBlock(start, juce::jmin(bufferSize, numSamples - start));
+
+        auto floatBlock = juce::dsp::AudioBlock<float>(linearPhaseBuffer)
+                              .getSubsetChannelBlock(0, subBlock.getNumChannels())
+                              .getSubBlock(0, subBlock.getNumSamples());
+
+        copyConverting(floatBlock, subBlock);
+        processLinearPhase(floatBlock);
+        copyConverting(subBlock, floatBlock);
+    }
+
+    doubleParametricBands.process(block);
+}
+
+void SimpleEQAudioProcessor::setActiveOversamplingOrder(int order)
+{
+    activeOversamplingOrder = order;
+
+    resetFilters();
+    prepareSvfChains();
+    resetActiveOversampler();
+
+    //the smoothed set belongs to the old rate too
+    if (isUsingSmoothedSet)
+        updateSmoothedFilters(ParameterCache::allBands);
+
+    updateParametricBands(ParameterCache::allParametricBands);
+}
+
+void SimpleEQAudioProcessor::resetActiveOversampler()
+{
+    //only the oversamplers for the host's precision exist
+    if (activeOversamplingOrder > 0)
+    {
+        if (auto& oversampler = oversamplers[(size_t) activeOversamplingOrder - 1])
+            oversampler->reset();
+
+        if (auto& oversampler = doubleOversamplers[(size_t) activeOversamplingOrder - 1])
+            oversampler->reset();
+    }
+}
+
+void SimpleEQAudioProcessor::setLinearPhaseActive(bool shouldBeActive)
+{
+    isLinearPhaseActive = shouldBeActive;
+
+    linearPhaseEngine.reset();
+
+    resetFilters();
+
+    resetActiveOversampler();
+
+    //the smoother stood still while the FIR was running, pick up from the current parameters
+    restartSmoothing();
+
+    //so were the state variable filters' ramps
+    if (! isLinearPhaseActive && activeFilterEngine == FilterEngine::stateVariable)
+        updateSvfTargets(true);
+
+    //the parametric bands move between the host rate and the oversampled one
+    updateParametricBands(ParameterCache::allParametricBands);
+}
+
+int SimpleEQAudioProcessor::getModeLatency(int oversamplingOrder, bool isLinearPhase) const noexcept
+{
+    return isLinearPhase ? linearPhaseLatency : oversamplingLatencies[(size_t) oversamplingOrder];
+}
+
+void SimpleEQAudioProcessor::processChannels(const juce::dsp::AudioBlock<float>& block)
+{
+    auto numChannels = block.getNumChannels();
+
+    //the parametric bands are the same for every channel group, they go ahead of the chains
+    parametricBands.process(block);
+
+    //the state variable chains have every band in them, whatever the precision mode
+    if (activeFilterEngine == FilterEngine::stateVariable)
+    {
+        processMonoChains(svfChains, block);
+        return;
+    }
+
+    //the cut bands kept in double go first, the float paths below have them switched off
+    if (hasDoublePrecisionBands)
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            if (channelDoubleBands[ch] != 0)
+                processDoublePrecisionBands(ch, block.getSingleChannelBlock(ch));
 
-    //extract individual channels from buffer which is wrapped in more audio block
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
+    //groups of channels go through one vectorised cascade each instead of a mono chain per channel
+    if (isSimdPathActive)
+    {
+        for (size_t first = 0; first < numChannels; first += SimdCascade::numLanes)
+        {
+            auto numLanes = juce::jmin(SimdCascade::numLanes, numChannels - first);
+            cascades[first / SimdCascade::numLanes].process(block.getSubsetChannelBlock(first, numLanes));
+        }
+
+        return;
+    }
+
+    processMonoChains(chains, block);
+}
+
+void SimpleEQAudioProcessor::processChannels(const juce::dsp::AudioBlock<double>& block)
+{
+    doubleParametricBands.process(block);
+
+    //double buffers always take the double chains, there's no SIMD cascade in double
+    if (activeFilterEngine == FilterEngine::stateVariable)
+        processMonoChains(doubleSvfChains, block);
+    else
+        processMonoChains(doubleChains, block);
+}
+
+template <typename ChainType, typename SampleType>
+void SimpleEQAudioProcessor::processMonoChains(std::vector<ChainType>& chainsToProcess, const juce::dsp::AudioBlock<SampleType>& block)
+{
+    for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+    {
+        //extract individual channels from buffer which is wrapped in more audio block
+        auto singleChannelBlock = block.getSingleChannelBlock(ch);
+
+        //create processing context that wraps the individual audio block
+        juce::dsp::ProcessContextReplacing<SampleType> context(singleChannelBlock);
+
+        //context that we pass to the mono filter chain
+        chainsToProcess[ch].process(context);
+    }
+}
+
+void SimpleEQAudioProcessor::processDoublePrecisionBands(size_t ch, const juce::dsp::AudioBlock<float>& channelBlock)
+{
+    auto numSamples = channelBlock.getNumSamples();
+    jassert(numSamples <= doublePrecisionBuffer.size());
+
+    double* channels[] = { doublePrecisionBuffer.data() };
+    juce::dsp::AudioBlock<double> doubleBlock(channels, 1, numSamples);
+
+    copyConverting(doubleBlock, channelBlock);
+
+    juce::dsp::ProcessContextReplacing<double> context(doubleBlock);
+    auto& chain = doubleChains[ch];
+
+    if (channelDoubleBands[ch] & ParameterCache::lowCutBand)
+        chain.get<ChainPositions::LowCut>().process(context);
 
-    //create processing context that wrap each individual audio block
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
+    if (channelDoubleBands[ch] & ParameterCache::highCutBand)
+        chain.get<ChainPositions::HighCut>().process(context);
 
-    //context that we pass to mono filter chains
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+    copyConverting(channelBlock, doubleBlock);
 }
 
 //==============================================================================
@@ -283,8 +1162,7 @@ bool SimpleEQAudioProcessor::hasEditor() const
 
 juce::AudioProcessorEditor* SimpleEQAudioProcessor::createEditor()
 {
-    //return new SimpleEQAudioProcessorEditor (*this);
-    return new juce::GenericAudioProcessorEditor(*this); //allows us to view what plugin currently looks like 
+    return new SimpleEQAudioProcessorEditor (*this);
 }
 
 //==============================================================================
@@ -293,12 +1171,27 @@ void SimpleEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
+   #if SIMPLEEQ_XML_STATE
+    StateSerialization::writeXml(apvts, destData);
+   #else
+    StateSerialization::writeBinary(*this, destData);
+   #endif
 }
 
 void SimpleEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
+
+    //the designer sees nothing until every parameter is in, then redesigns the bands that changed once
+    ParameterCache::ScopedBatch batch(parameterCache);
+
+    switch (StateSerialization::detectFormat(data, sizeInBytes))
+    {
+        case StateSerialization::Format::binary:    StateSerialization::readBinary(*this, data, sizeInBytes); break;
+        case StateSerialization::Format::xml:       StateSerialization::readXml(apvts, data, sizeInBytes); break;
+        case StateSerialization::Format::unknown:   break;
+    }
 }
 
 /************************************EDITS***********************************/
@@ -372,6 +1265,62 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleEQAudioProcessor::crea
     layout.add(std::make_unique<juce::AudioParameterChoice>("LowCut Slope", "LowCutSlope", stringArray, 0));
     layout.add(std::make_unique<juce::AudioParameterChoice>("HighCut Slope", "HighCutSlope", stringArray, 0));
 
+    //runs the filters at 2x/4x/8x the host rate so the peak and high cut don't cramp near nyquist
+    //the choice index is the oversampling order
+    layout.add(std::make_unique<juce::AudioParameterChoice>("Oversampling", "Oversampling",
+        juce::StringArray{ "Off", "2x", "4x", "8x" }, 0));
+
+    //runs the same curve as a linear phase FIR for mastering, at the cost of about 100 ms of latency
+    layout.add(std::make_unique<juce::AudioParameterBool>("Linear Phase", "Linear Phase", false));
+
+    //dynamic EQ: the peak's gain moves with the level around its frequency, on the input or the sidechain
+    layout.add(std::make_unique<juce::AudioParameterBool>("Dynamic", "Dynamic", false));
+    layout.add(std::make_unique<juce::AudioParameterBool>("Dynamic Sidechain", "Dynamic Sidechain", false));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>("Dynamic Threshold",
+        "Dynamic Threshold",
+        juce::NormalisableRange<float>(-60.f, 0.f, 0.5f, 1.f),
+        -24.f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>("Dynamic Ratio",
+        "Dynamic Ratio",
+        juce::NormalisableRange<float>(1.f, 20.f, 0.1f, 0.5f),
+        2.f));
+
+    //how far the gain can move from the peak's own gain, negative cuts the band as it gets louder
+    layout.add(std::make_unique<juce::AudioParameterFloat>("Dynamic Range",
+        "Dynamic Range",
+        juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
+        -6.f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>("Dynamic Attack",
+        "Dynamic Attack",
+        juce::NormalisableRange<float>(0.1f, 200.f, 0.1f, 0.4f),
+        10.f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>("Dynamic Release",
+        "Dynamic Release",
+        juce::NormalisableRange<float>(5.f, 2000.f, 1.f, 0.4f),
+        150.f));
+
+    //the extra bands of the parametric engine, all off to start with and spread evenly across the range
+    for (int band = 0; band < maxParametricBands; ++band)
+    {
+        auto defaultFrequency = std::round(20.f * std::pow(1000.f, ((float) band + 0.5f) / (float) maxParametricBands));
+
+        layout.add(std::make_unique<juce::AudioParameterChoice>(getBandParameterID(band, "Type"), getBandParameterID(band, "Type"),
+            juce::StringArray{ "Off", "Peak", "Low Shelf", "High Shelf", "Notch" }, 0));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(getBandParameterID(band, "Freq"), getBandParameterID(band, "Freq"),
+            juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), defaultFrequency));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(getBandParameterID(band, "Gain"), getBandParameterID(band, "Gain"),
+            juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f), 0.0f));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(getBandParameterID(band, "Quality"), getBandParameterID(band, "Quality"),
+            juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f), 1.f));
+    }
+
     return layout;
 }
 
@@ -9,30 +9,26 @@
 #pragma once
 
 #include <JuceHeader.h>
-
-enum Slope
-{
-    Slope_12,
-    Slope_24,
-    Slope_36,
-    Slope_48
-};
-
-//create a data structure to extract parameters from audio processor value tree state
-struct ChainSettings
-{
-    float peakFreq{ 0 }, peakGainInDecibels{ 0 }, peakQuality{ 1.f };
-    float lowCutFreq{ 0 }, highCutFreq{ 0 };
-    Slope lowCutSlope{Slope::Slope_12}, highCutSlope{ Slope::Slope_12};
-};
-
-
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
+#include "ChainSettings.h"
+#include "FilterCoefficients.h"
+#include "ParameterCache.h"
+#include "CoefficientDesigner.h"
+#include "SimdCascade.h"
+#include "SvfFilters.h"
+#include "CutCascade.h"
+#include "ParametricBands.h"
+#include "DynamicBand.h"
+#include "ParameterSmoother.h"
+#include "RealtimeSafety.h"
+#include "SpectrumAnalyzer.h"
+#include "DspLoadMeter.h"
+#include "StateSerialization.h"
 
 //==============================================================================
 /**
 */
-class SimpleEQAudioProcessor  : public juce::AudioProcessor
+class SimpleEQAudioProcessor  : public juce::AudioProcessor,
+                                private juce::Timer
 {
 public:
     //==============================================================================
@@ -48,6 +44,10 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    //a host sending double buffers gets the whole chain run in double
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -77,23 +77,134 @@ public:
 
     juce::AudioProcessorValueTreeState apvts{ *this, nullptr, "Parameters", createParameterLayout()};
 
+    //designs the cut filters from a per sample rate lookup table instead of the Butterworth helpers
+    void setUseCutFilterTable(bool shouldUseTable) { coefficientDesigner.setUseCutFilterTable(shouldUseTable); }
+    size_t getCutFilterTableFootprint() const noexcept { return coefficientDesigner.getCutFilterTableFootprint(); }
+
+    //runs the channels through SIMD cascades, one channel per lane, instead of one MonoChain each
+    //off by default, the MonoChains stay the reference the SIMD path is checked against, safe to call from any thread
+    void setUseSimdProcessing(bool shouldUseSimd) noexcept { useSimdProcessing = shouldUseSimd; }
+
+    //gives the channels of a surround group their own settings instead of following the parameters
+    void setChannelGroupSettings(ChannelGroup group, const ChainSettings& settings) { coefficientDesigner.setChannelGroupSettings(group, settings); }
+    void linkChannelGroup(ChannelGroup group) { coefficientDesigner.linkChannelGroup(group); }
+
+    //largest bus the chain pool is sized for
+    static constexpr int maxNumChannels = 64;
+
+    //the "Oversampling" choices run the filters at up to 2^maxOversamplingOrder times the host rate
+    static constexpr int maxOversamplingOrder = 3;
+
+    //splits each block into sub-blocks of this many samples and ramps the parameters between them,
+    //0 turns smoothing off so coefficients only change once per block, safe to call from any thread
+    void setSmoothingSubBlockSize(int numSamples) noexcept { smoothingSubBlockSize = juce::jmax(0, numSamples); }
+
+    //which cut bands keep their filter state in double when the host sends float buffers
+    enum class PrecisionMode
+    {
+        singlePrecision,    //everything in float
+        automatic,          //only the cut bands with poles too close to z = 1 for float, like a 20 Hz low cut at 192 kHz
+        doublePrecision     //both cut bands always
+    };
+
+    //safe to call from any thread
+    void setPrecisionMode(PrecisionMode mode) noexcept { precisionMode = mode; }
+
+    //ParameterCache bits of the cut bands a channel currently runs in double, read it between blocks
+    int getChannelDoublePrecisionBands(int channel) const noexcept { return channelDoubleBands[(size_t) channel]; }
+
+    //what fills the cut and peak slots of the chains
+    enum class FilterEngine
+    {
+        biquad,             //IIR::Filter biquads, designed on the background thread and smoothed per sub-block
+        stateVariable       //TPT state variable filters that follow the parameters sample by sample
+    };
+
+    //safe to call from any thread
+    void setFilterEngine(FilterEngine engine) noexcept { filterEngine = engine; }
+
+    //how many of the "Band n" parameters are run, from 0 to maxParametricBands
+    //message thread, takes effect at the next prepareToPlay since that's where the engine is sized
+    void setNumParametricBands(int numBands) noexcept { numParametricBands = juce::jlimit(0, maxParametricBands, numBands); }
+
+    //skips the filters once the input has been silent for longer than the tail, on by default
+    //safe to call from any thread
+    void setIdleDetection(bool shouldDetectIdle) noexcept { useIdleDetection = shouldDetectIdle; }
+    bool isIdle() const noexcept { return isIdleActive.load(std::memory_order_relaxed); }
+
+    //the longest tail getTailLengthSeconds reports, a filter that would ring for longer is cut off here
+    static constexpr double maxTailSeconds = 10.0;
+
+    //pre and post EQ spectrum, the editor switches it on while it's open
+    SpectrumAnalyzer& getSpectrumAnalyzer() noexcept { return spectrumAnalyzer; }
+
+    //share of the real time budget each block takes, and which stages of processBlock it goes on
+    DspLoadMeter& getLoadMeter() noexcept { return loadMeter; }
+
 private:
+    //reports the latency of the mode the audio thread switched to, the host is only told on the message thread
+    void timerCallback() override;
 
     /* DSP namespace uses a lot of templates and nested namespaces*/
     // we can create type aliases to elimnate namespace and template definitions
     
     //we can put 4 filters in prcoessor chain to pass a single context and process all audio automatically
     //each filter in IIR filter has response of 12 dB/oct for low/high pass filter
-    using Filter = juce::dsp::IIR::Filter<float>; //peak filter
+    template <typename SampleType>
+    using Filter = juce::dsp::IIR::Filter<SampleType>; //peak filter
 
-    //define a chain pass a single context and process audio automatically
-    using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
+    //the 1 to 4 sections of a cut band, with a processing loop compiled for each Slope
+    template <typename SampleType>
+    using CutFilter = CutCascade<SampleType>;
 
     //use filter for mono signal path
-    using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
+    template <typename SampleType>
+    using MonoChain = juce::dsp::ProcessorChain<CutFilter<SampleType>, Filter<SampleType>, CutFilter<SampleType>>;
+
+    //one chain per channel of the main bus, allocated in prepareToPlay
+    std::vector<MonoChain<float>> chains;
 
-    //stereo processing
-    MonoChain leftChain, rightChain;
+    //the same chains in double, for double buffers and for the cut bands that run in double on float buffers
+    std::vector<MonoChain<double>> doubleChains;
+
+    //the same chains with state variable filters in the cut and peak slots
+    template <typename SampleType>
+    using SvfChain = juce::dsp::ProcessorChain<SvfCutFilter<SampleType>, SvfPeakFilter<SampleType>, SvfCutFilter<SampleType>>;
+
+    std::vector<SvfChain<float>> svfChains;
+    std::vector<SvfChain<double>> doubleSvfChains;
+
+    std::atomic<FilterEngine> filterEngine{ FilterEngine::biquad };
+    FilterEngine activeFilterEngine{ FilterEngine::biquad };
+
+    //the same 9 stages for SimdCascade::numLanes channels at once, one channel per lane
+    std::vector<SimdCascade> cascades;
+    std::atomic<bool> useSimdProcessing{ false };
+    bool isSimdPathActive{ false };
+
+    //the extra peak, shelf and notch bands, the same for every channel and only built in the host's precision
+    ParametricBands<float> parametricBands;
+    ParametricBands<double> doubleParametricBands;
+    std::atomic<int> numParametricBands{ maxParametricBands };
+
+    template <typename SampleType>
+    ParametricBands<SampleType>& getParametricBands() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleParametricBands;
+        else
+            return parametricBands;
+    }
+
+    //designs the given parametric bands (ParameterCache::allParametricBands bits) at the rate they run at
+    void updateParametricBands(juce::uint32 bands);
+
+    //how long each parametric band rings, in samples at the rate it runs at, and all of them together
+    std::array<double, (size_t) maxParametricBands> parametricBandDecayLengths{};
+    std::atomic<double> parametricTailSeconds{ 0 };
+
+    //which ChannelGroup's coefficients each channel uses
+    std::vector<ChannelGroup> channelGroups;
 
     //enums for get function in the chain
     enum ChainPositions
@@ -104,58 +215,212 @@ private:
     };
     
     //refactoring the DSP
-    void updatePeakFilter(const ChainSettings& chainSettings);
-    using Coefficients = Filter::CoefficientsPtr;
-    static void updateCoefficients(Coefficients& old, const Coefficients& replacements);
-
-    template<int Index, typename ChainType, typename CoefficientType>
-    void update(ChainType& chain, const CoefficientType& coefficients)
-    { 
-        updateCoefficients(chain.template get<Index>().coefficients, coefficients[Index]);
-        chain.template setBypassed<Index> (false);
+    template <typename ChainType>
+    void updatePeakFilter(ChainType& chain, const BiquadCoefficients& peakCoefficients);
+
+    //copies into the storage the filter already owns so nothing is allocated on the audio thread,
+    //rounding the double designs for float filters
+    template <typename CoefficientsPtr>
+    static void updateCoefficients(CoefficientsPtr& old, const BiquadCoefficients& replacements);
+
+    template <typename ChainType>
+    void updateLowCutFilters(ChainType& chain, const FilterCoefficientSet& coefficientSet);
+    template <typename ChainType>
+    void updateHighCutFilters(ChainType& chain, const FilterCoefficientSet& coefficientSet);
+
+    //copies the given bands of a set into one channel's filters, in whichever precision the channel runs them
+    void applyToChannel(size_t channel, const FilterCoefficientSet& coefficientSet, int bands);
+
+    //copies the sets published by the designer into every channel, using the set of the channel's group
+    //while the smoother ramps, the linked groups get the smoothed set instead
+    void updateFilters(const ChannelGroupCoefficients& groupCoefficients);
+
+    //redesigns the given bands from the smoothed settings and copies them into the linked channels
+    void updateSmoothedFilters(int bands);
+
+    //once per block: hands the linked groups to the smoothed set when a ramp starts,
+    //and back to the designer's set once the ramps have settled on what it was designed from
+    void updateSmoothing();
+
+    //starts the ramps from the current parameters, after smoothing is switched on or the smoother stood still
+    void restartSmoothing();
+
+    //gives the linked groups the designer's set again, if they were running the smoothed one
+    void releaseSmoothedSet();
+
+    //smoothing is on and the biquads are the ones running, the only time the smoother has anything to do
+    bool isSmoothingActive() const noexcept
+    {
+        return activeSubBlockSize > 0 && activeFilterEngine == FilterEngine::biquad && ! isLinearPhaseActive;
     }
 
-    template<typename ChainType, typename CoefficientType>
-    void updateCutFilter(ChainType& chain, 
-                        const CoefficientType& coefficients,
-//                      const ChainSettings& chainSettings, 
-                        const Slope& slope)
+    //runs the detector over a sub-block and gives the linked channels' peak its dynamic gain
+    template <typename SampleType>
+    void updateDynamicPeak(const juce::dsp::AudioBlock<SampleType>& detectorBlock, const DynamicSettings& dynamicSettings);
+
+    //copies a peak biquad into one channel's filters, for the gain-only updates of the dynamic mode
+    void applyPeakToChannel(size_t channel, const BiquadCoefficients& peakCoefficients);
+
+    //switches the dynamic mode on or off, the peak goes back to its designed gain when it's off
+    void setDynamicActive(bool shouldBeActive);
+
+    //points the state variable chains at the current settings of their channel's group, ramping unless shouldJump
+    void updateSvfTargets(bool shouldJump);
+
+    template <typename SampleType>
+    void setSvfTargets(SvfChain<SampleType>& chain, const ChainSettings& settings, double rampLengthSeconds, bool shouldJump);
+
+    //gives the state variable chains the rate the filters run at, keeping their targets
+    void prepareSvfChains();
+
+    //switches between the biquads and the state variable filters, starting the new ones from silence
+    void setActiveFilterEngine(FilterEngine engine);
+
+    //everything processBlock does, for float or double buffers
+    template <typename SampleType>
+    void processBuffer(juce::AudioBuffer<SampleType>& buffer);
+
+    //runs a block or sub-block through the active processing path
+    void processChannels(const juce::dsp::AudioBlock<float>& block);
+    void processChannels(const juce::dsp::AudioBlock<double>& block);
+
+    //one chain per channel, for the paths without a SIMD cascade
+    template <typename ChainType, typename SampleType>
+    static void processMonoChains(std::vector<ChainType>& chainsToProcess, const juce::dsp::AudioBlock<SampleType>& block);
+
+    //runs the cut bands a float channel keeps in double, on a double copy of the channel
+    void processDoublePrecisionBands(size_t channel, const juce::dsp::AudioBlock<float>& channelBlock);
+
+    //ramps the smoothed parameters and follows the dynamic peak's detector across the block,
+    //in sub-blocks of activeSubBlockSize, or dynamicSubBlockSize when only the dynamic mode needs them
+    template <typename SampleType>
+    void processSubBlocks(const juce::dsp::AudioBlock<SampleType>& block,
+                          const juce::dsp::AudioBlock<SampleType>& detectorBlock,
+                          const DynamicSettings& dynamicSettings);
+
+    //runs processChannels at the active oversampled rate
+    template <typename SampleType>
+    void processOversampled(const juce::dsp::AudioBlock<SampleType>& block);
+
+    //the FIR engine is float only, double buffers go through it via linearPhaseBuffer
+    void processLinearPhase(const juce::dsp::AudioBlock<float>& block);
+    void processLinearPhase(const juce::dsp::AudioBlock<double>& block);
+
+    //the cut bands a float channel should run in double for a set, with some hysteresis around the threshold
+    int getDoublePrecisionBands(const FilterCoefficientSet& coefficientSet, int bands, int currentDoubleBands) const noexcept;
+
+    //picks up a new PrecisionMode, starting every filter from silence
+    void setActivePrecisionMode(PrecisionMode mode);
+
+    void resetFilters();
+
+    //clears the oversampler the current order uses
+    void resetActiveOversampler();
+
+    //switches to the oversampler for a new order and clears the filter state, which belongs to the old rate
+    void setActiveOversamplingOrder(int order);
+
+    //the rate the filters currently run at
+    double getProcessingSampleRate() const { return getSampleRate() * (1 << activeOversamplingOrder); }
+
+    //switches between the IIR chains and the linear phase engine, starting the new one from silence
+    void setLinearPhaseActive(bool shouldBeActive);
+
+    //what to report to the host for a processing mode
+    int getModeLatency(int oversamplingOrder, bool isLinearPhase) const noexcept;
+
+    //gives the peak filter its own biquad sized coefficient object, called before the chains are prepared
+    template <typename SampleType>
+    static void prepareCoefficientStorage(MonoChain<SampleType>& chain);
+
+    //one polyphase half-band oversampler per order, all built in prepareToPlay so switching never allocates,
+    //only the set for the precision the host processes in is built
+    template <typename SampleType>
+    using Oversamplers = std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, (size_t) maxOversamplingOrder>;
+
+    Oversamplers<float> oversamplers;
+    Oversamplers<double> doubleOversamplers;
+
+    //builds the oversamplers of one precision and records their latencies
+    template <typename SampleType>
+    void prepareOversamplers(size_t numChannels);
+
+    template <typename SampleType>
+    Oversamplers<SampleType>& getOversamplers() noexcept
     {
-      
-        chain.template setBypassed<0>(true);
-        chain.template setBypassed<1>(true);
-        chain.template setBypassed<2>(true);
-        chain.template setBypassed<3>(true);
-
-       
-        switch (slope)
-        {
-            case Slope_48:
-            {
-                update<3>(chain, coefficients);
-                //Does the same thing as this
-                //*leftlowcut.template get<3>().coefficients = *cutcoefficients[3]; //get first filter and assign to first element cut coeefficients
-                //leftlowcut.template setbypassed<3>(false);
-            }
-            case Slope_36:
-            {
-                update<2>(chain, coefficients);
-            }
-            case Slope_24:
-            {
-                update<1>(chain, coefficients);
-            }
-            case Slope_12:
-            {
-                update<0>(chain, coefficients);
-            }
-        }   //switch
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleOversamplers;
+        else
+            return oversamplers;
     }
 
-    void updateLowCutFilters(const ChainSettings& chainSettings);
-    void updateHighCUtFilters(const ChainSettings& chainSettings);
+    //latency in samples for each order, 0 for no oversampling, read by the audio thread along with linearPhaseLatency
+    std::array<int, (size_t) maxOversamplingOrder + 1> oversamplingLatencies{};
+
+    int activeOversamplingOrder{ 0 };
+    size_t oversamplingBlockSize{ 0 };
+
+    //FIR version of the curve, runs at the host rate whatever the oversampling is set to
+    LinearPhaseEngine linearPhaseEngine;
+    bool isLinearPhaseActive{ false };
+    int linearPhaseLatency{ 0 };
+
+    //latency of the mode the audio thread is running, stored when it switches and picked up by timerCallback
+    std::atomic<int> activeModeLatency{ 0 };
+    static constexpr int latencyPollsPerSecond = 30;
+    juce::AudioBuffer<float> linearPhaseBuffer;
+
+    std::atomic<PrecisionMode> precisionMode{ PrecisionMode::automatic };
+    PrecisionMode activePrecisionMode{ PrecisionMode::automatic };
+
+    //ParameterCache band bits of the cut bands each channel runs in double, always 0 for double buffers
+    std::vector<int> channelDoubleBands;
+    bool hasDoublePrecisionBands{ false };
+
+    //one channel of an oversampled block, for processDoublePrecisionBands
+    std::vector<double> doublePrecisionBuffer;
 
-    void updateFilters();
+    ParameterCache parameterCache{ apvts };
+
+    //designs the coefficients on a background thread, processBlock only picks them up
+    CoefficientDesigner coefficientDesigner{ parameterCache };
+
+    //the last sets the designer published, kept so they can be reapplied when smoothing is switched off
+    ChannelGroupCoefficients designedCoefficients;
+
+    //while the smoother ramps, the linked groups get coefficients designed on the audio thread once per sub-block,
+    //the rest of the time they run the designer's set like with smoothing off
+    ParameterSmoother smoother;
+    FilterCoefficientSet smoothedSet;
+    std::atomic<int> smoothingSubBlockSize{ 32 };
+    int activeSubBlockSize{ 0 };
+    bool isUsingSmoothedSet{ false };
+
+    static constexpr double smoothingTimeSeconds = 0.02;
+
+    //the peak's gain follows a level detector, on the main input or the sidechain bus
+    //only for the biquad engine outside linear phase mode, and only in the linked groups
+    DynamicBand dynamicPeak;
+    PeakGainDesign dynamicPeakDesign;
+    bool isDynamicActive{ false };
+
+    static constexpr int dynamicSubBlockSize = 32;
+
+    //samples of input below silenceThreshold since the last one above it, once they cover the tail nothing is processed
+    std::atomic<bool> useIdleDetection{ true };
+    std::atomic<bool> isIdleActive{ false };
+    juce::int64 numSilentSamples{ 0 };
+
+    //clears what's left of the filters on the way in, and jumps the ramps to the parameters on the way out
+    void setIdle(bool shouldBeIdle);
+
+    SpectrumAnalyzer spectrumAnalyzer;
+    DspLoadMeter loadMeter;
+
+   #if SIMPLEEQ_RT_SAFETY_CHECKS
+    //writes the violations processBlock reports to the log, shared by every instance
+    juce::SharedResourcePointer<RealtimeSafety::ViolationLogThread> violationLog;
+   #endif
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessor)
@@ -0,0 +1,329 @@
+/*
+  ==============================================================================
+
+    RealtimeSafety.cpp
+
+  ==============================================================================
+*/
+
+#include "RealtimeSafety.h"
+
+#if SIMPLEEQ_RT_SAFETY_CHECKS
+
+#include <new>
+#include <cstdlib>
+
+#if JUCE_MSVC
+ #include <malloc.h>
+#endif
+
+#if JUCE_LINUX
+ #include <dlfcn.h>
+ #include <pthread.h>
+#endif
+
+namespace RealtimeSafety
+{
+namespace
+{
+    constexpr auto numViolationTypes = static_cast<size_t>(ViolationType::numTypes);
+
+    thread_local bool isAudioThreadFlag = false;
+    thread_local juce::int64 threadViolationCounts[numViolationTypes]{};
+
+    std::atomic<juce::int64> totalViolationCount{ 0 };
+    std::atomic<bool> isLoggingEnabled{ true };
+
+    //bounded multi producer, single consumer queue, any number of audio threads can report
+    //into it without locking or allocating and the log thread is the only reader
+    class ViolationQueue
+    {
+    public:
+        ViolationQueue() noexcept
+        {
+            for (size_t i = 0; i < capacity; ++i)
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        //false when the log thread has fallen behind, the violation is still counted
+        bool push(const Violation& violation) noexcept
+        {
+            auto position = writePosition.load(std::memory_order_relaxed);
+
+            for (;;)
+            {
+                auto& slot = slots[position & mask];
+                auto sequence = slot.sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+                if (difference == 0)
+                {
+                    if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        slot.violation = violation;
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = writePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool pop(Violation& violation) noexcept
+        {
+            auto& slot = slots[readPosition & mask];
+            auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+            if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(readPosition + 1) < 0)
+                return false;
+
+            violation = slot.violation;
+            slot.sequence.store(readPosition + capacity, std::memory_order_release);
+            ++readPosition;
+            return true;
+        }
+
+        std::atomic<juce::int64> numDropped{ 0 };
+
+    private:
+        static constexpr size_t capacity = 1024;
+        static constexpr size_t mask = capacity - 1;
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence{ 0 };
+            Violation violation;
+        };
+
+        std::array<Slot, capacity> slots;
+        std::atomic<size_t> writePosition{ 0 };
+        size_t readPosition{ 0 };
+    };
+
+    //only touched once a thread has been marked as the audio thread, long after static initialisation
+    ViolationQueue queue;
+
+    const char* getName(ViolationType type) noexcept
+    {
+        switch (type)
+        {
+            case ViolationType::allocation:     return "allocation";
+            case ViolationType::deallocation:   return "deallocation";
+            case ViolationType::mutexLock:      return "mutex lock";
+            case ViolationType::numTypes:       break;
+        }
+
+        return "unknown";
+    }
+}
+
+ScopedAudioThread::ScopedAudioThread() noexcept
+    : wasAudioThread(isAudioThreadFlag)
+{
+    isAudioThreadFlag = true;
+}
+
+ScopedAudioThread::~ScopedAudioThread() noexcept
+{
+    isAudioThreadFlag = wasAudioThread;
+}
+
+bool isAudioThread() noexcept
+{
+    return isAudioThreadFlag;
+}
+
+juce::int64 getThreadViolationCount(ViolationType type) noexcept
+{
+    return threadViolationCounts[static_cast<size_t>(type)];
+}
+
+juce::int64 getThreadViolationCount() noexcept
+{
+    juce::int64 total = 0;
+
+    for (auto count : threadViolationCounts)
+        total += count;
+
+    return total;
+}
+
+juce::int64 getTotalViolationCount() noexcept
+{
+    return totalViolationCount.load(std::memory_order_relaxed);
+}
+
+void setLoggingEnabled(bool shouldLog) noexcept
+{
+    isLoggingEnabled.store(shouldLog, std::memory_order_relaxed);
+}
+
+void reportViolation(ViolationType type, size_t size) noexcept
+{
+    if (! isAudioThreadFlag)
+        return;
+
+    ++threadViolationCounts[static_cast<size_t>(type)];
+    totalViolationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (isLoggingEnabled.load(std::memory_order_relaxed)
+        && ! queue.push({ type, size, juce::Thread::getCurrentThreadId() }))
+        queue.numDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+//==============================================================================
+ViolationLogThread::ViolationLogThread()
+    : juce::Thread("Real-time safety log")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+ViolationLogThread::~ViolationLogThread()
+{
+    stopThread(1000);
+    drain();
+}
+
+void ViolationLogThread::run()
+{
+    while (! threadShouldExit())
+    {
+        drain();
+        wait(50);
+    }
+}
+
+void ViolationLogThread::drain()
+{
+    Violation violation;
+
+    while (queue.pop(violation))
+    {
+        juce::String message("Real-time violation: ");
+        message << getName(violation.type);
+
+        if (violation.size > 0)
+            message << " of " << (juce::int64) violation.size << " bytes";
+
+        message << " on thread 0x" << juce::String::toHexString((juce::pointer_sized_int) violation.thread);
+
+        juce::Logger::writeToLog(message);
+    }
+
+    if (auto numDropped = queue.numDropped.exchange(0))
+        juce::Logger::writeToLog("Real-time violation log fell behind, " + juce::String(numDropped) + " violations not logged");
+}
+}
+
+//==============================================================================
+//replacements for the global allocation functions, the nothrow and array forms are replaced
+//as well because not every standard library routes them through the plain operator new
+namespace
+{
+    using RealtimeSafety::ViolationType;
+
+    void* allocate(std::size_t size) noexcept
+    {
+        RealtimeSafety::reportViolation(ViolationType::allocation, size);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    //std::aligned_alloc isn't in MSVC's runtime, and whatever allocates aligned has to free aligned there too
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+    {
+        RealtimeSafety::reportViolation(ViolationType::allocation, size);
+
+        auto align = juce::jmax(sizeof(void*), static_cast<std::size_t>(alignment));
+
+       #if JUCE_MSVC
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+       #else
+        void* ptr = nullptr;
+        return posix_memalign(&ptr, align, size == 0 ? 1 : size) == 0 ? ptr : nullptr;
+       #endif
+    }
+
+    void deallocate(void* ptr) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+
+        RealtimeSafety::reportViolation(ViolationType::deallocation, 0);
+        std::free(ptr);
+    }
+
+    void deallocateAligned(void* ptr) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+
+        RealtimeSafety::reportViolation(ViolationType::deallocation, 0);
+
+       #if JUCE_MSVC
+        _aligned_free(ptr);
+       #else
+        std::free(ptr);
+       #endif
+    }
+
+    void* throwIfNull(void* ptr)
+    {
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+
+        return ptr;
+    }
+}
+
+void* operator new (std::size_t size)                                                       { return throwIfNull(allocate(size)); }
+void* operator new[] (std::size_t size)                                                     { return throwIfNull(allocate(size)); }
+void* operator new (std::size_t size, std::align_val_t alignment)                           { return throwIfNull(allocateAligned(size, alignment)); }
+void* operator new[] (std::size_t size, std::align_val_t alignment)                         { return throwIfNull(allocateAligned(size, alignment)); }
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept                       { return allocate(size); }
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept                     { return allocate(size); }
+void* operator new (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept   { return allocateAligned(size, alignment); }
+void* operator new[] (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+
+void operator delete (void* ptr) noexcept                                                   { deallocate(ptr); }
+void operator delete[] (void* ptr) noexcept                                                 { deallocate(ptr); }
+void operator delete (void* ptr, std::size_t) noexcept                                      { deallocate(ptr); }
+void operator delete[] (void* ptr, std::size_t) noexcept                                    { deallocate(ptr); }
+void operator delete (void* ptr, std::align_val_t) noexcept                                 { deallocateAligned(ptr); }
+void operator delete[] (void* ptr, std::align_val_t) noexcept                               { deallocateAligned(ptr); }
+void operator delete (void* ptr, std::size_t, std::align_val_t) noexcept                    { deallocateAligned(ptr); }
+void operator delete[] (void* ptr, std::size_t, std::align_val_t) noexcept                  { deallocateAligned(ptr); }
+void operator delete (void* ptr, const std::nothrow_t&) noexcept                            { deallocate(ptr); }
+void operator delete[] (void* ptr, const std::nothrow_t&) noexcept                          { deallocate(ptr); }
+void operator delete (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept          { deallocateAligned(ptr); }
+void operator delete[] (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept        { deallocateAligned(ptr); }
+
+//==============================================================================
+#if JUCE_LINUX
+//every lock taken through juce::CriticalSection, std::mutex or a plain pthread mutex ends up here,
+//the real function is looked up lazily because this can run before static initialisation
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+{
+    using LockFunction = int (*)(pthread_mutex_t*);
+    static std::atomic<LockFunction> realLock{ nullptr };
+
+    auto lock = realLock.load(std::memory_order_acquire);
+
+    if (lock == nullptr)
+    {
+        lock = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        realLock.store(lock, std::memory_order_release);
+    }
+
+    RealtimeSafety::reportViolation(ViolationType::mutexLock, 0);
+    return lock(mutex);
+}
+#endif
+
+#endif
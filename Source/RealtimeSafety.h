@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    RealtimeSafety.h
+
+    Opt-in detector for things the audio thread must never do. Build with
+    SIMPLEEQ_RT_SAFETY_CHECKS=1 and every heap allocation, deallocation or
+    mutex lock made while a ScopedAudioThread is alive counts as a violation.
+
+    Violations are counted per thread, so a test or benchmark can check the
+    count before and after processBlock, and pushed onto a lock-free queue that
+    a ViolationLogThread drains into the juce::Logger.
+
+    operator new/delete are replaced for the whole binary. pthread_mutex_lock
+    is wrapped on Linux only. A plugin built with hidden visibility only sees
+    its own calls, so the host's allocations are never counted.
+
+    With the macro at 0 (the default) everything here compiles to nothing.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef SIMPLEEQ_RT_SAFETY_CHECKS
+ #define SIMPLEEQ_RT_SAFETY_CHECKS 0
+#endif
+
+namespace RealtimeSafety
+{
+    enum class ViolationType
+    {
+        allocation,
+        deallocation,
+        mutexLock,
+
+        numTypes
+    };
+
+    struct Violation
+    {
+        ViolationType type{ ViolationType::allocation };
+        size_t size{ 0 };
+        juce::Thread::ThreadID thread{ nullptr };
+    };
+
+   #if SIMPLEEQ_RT_SAFETY_CHECKS
+    //marks the calling thread as the audio thread for the lifetime of the object, nests
+    class ScopedAudioThread
+    {
+    public:
+        ScopedAudioThread() noexcept;
+        ~ScopedAudioThread() noexcept;
+
+    private:
+        bool wasAudioThread;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudioThread)
+    };
+
+    bool isAudioThread() noexcept;
+
+    //violations of one type made by the calling thread since it started
+    juce::int64 getThreadViolationCount(ViolationType type) noexcept;
+
+    //every type added up
+    juce::int64 getThreadViolationCount() noexcept;
+
+    //violations made by every thread in the process
+    juce::int64 getTotalViolationCount() noexcept;
+
+    //stops violations from being queued for the log, they are still counted
+    void setLoggingEnabled(bool shouldLog) noexcept;
+
+    //called by the interceptors, only records anything on a thread marked as the audio thread
+    void reportViolation(ViolationType type, size_t size) noexcept;
+
+    //drains the queue into the juce::Logger, hold it through a SharedResourcePointer
+    class ViolationLogThread : private juce::Thread
+    {
+    public:
+        ViolationLogThread();
+        ~ViolationLogThread() override;
+
+    private:
+        void run() override;
+        void drain();
+    };
+   #else
+    struct ScopedAudioThread
+    {
+        ScopedAudioThread() noexcept {}
+    };
+
+    inline bool isAudioThread() noexcept                                 { return false; }
+    inline juce::int64 getThreadViolationCount(ViolationType) noexcept  { return 0; }
+    inline juce::int64 getThreadViolationCount() noexcept                { return 0; }
+    inline juce::int64 getTotalViolationCount() noexcept                 { return 0; }
+    inline void setLoggingEnabled(bool) noexcept                         {}
+    inline void reportViolation(ViolationType, size_t) noexcept          {}
+   #endif
+}
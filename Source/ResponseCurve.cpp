@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.cpp
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+
+namespace
+{
+    //|H|^2 of b0 + b1 z^-1 + b2 z^-2 is c0 + c1 s + c2 s^2 with s = sin^2(w / 2),
+    //the same form gives the denominator with 1, a1, a2
+    struct SquaredMagnitudePolynomial
+    {
+        double c0, c1, c2;
+    };
+
+    SquaredMagnitudePolynomial getPolynomial(double x0, double x1, double x2) noexcept
+    {
+        auto sum = x0 + x1 + x2;
+        return { sum * sum, -4.0 * (x0 * x1 + x1 * x2 + 4.0 * x0 * x2), 16.0 * x0 * x2 };
+    }
+
+    //anything quieter than this is off the bottom of the display anyway
+    constexpr float minDecibels = -200.f;
+}
+
+void ResponseCurve::prepare(int newNumPoints, double newSampleRate)
+{
+    numPoints = newNumPoints;
+    sampleRate = newSampleRate;
+
+    auto numRegisters = ((size_t) numPoints + numLanes - 1) / numLanes;
+
+    sinSquared.assign(numRegisters, Register::expand(0.0));
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        auto halfOmega = juce::MathConstants<double>::pi * getFrequencyForPoint(i, numPoints) / sampleRate;
+        auto sine = std::sin(juce::jmin(halfOmega, juce::MathConstants<double>::halfPi));
+
+        sinSquared[(size_t) i / numLanes].set((size_t) i % numLanes, sine * sine);
+    }
+
+    //a flat band is 1 / 1 everywhere
+    for (auto& band : bands)
+    {
+        band.numerator.assign(numRegisters, Register::expand(1.0));
+        band.denominator.assign(numRegisters, Register::expand(1.0));
+    }
+
+    decibels.assign((size_t) numPoints, 0.f);
+}
+
+float ResponseCurve::getFrequencyForPoint(int index, int numPoints) noexcept
+{
+    if (numPoints < 2)
+        return minFrequency;
+
+    return minFrequency * std::pow(maxFrequency / minFrequency, (float) index / (float) (numPoints - 1));
+}
+
+void ResponseCurve::update(const FilterCoefficientSet& coefficientSet, int changedBands) noexcept
+{
+    if (changedBands & ParameterCache::lowCutBand)
+        evaluate(coefficientSet.lowCut.data(), getNumCutSections(coefficientSet.lowCutSlope), bands[0]);
+
+    if (changedBands & ParameterCache::peakBand)
+        evaluate(&coefficientSet.peak, 1, bands[1]);
+
+    if (changedBands & ParameterCache::highCutBand)
+        evaluate(coefficientSet.highCut.data(), getNumCutSections(coefficientSet.highCutSlope), bands[2]);
+
+    if (changedBands != 0)
+        combine();
+}
+
+void ResponseCurve::evaluate(const BiquadCoefficients* stages, int numStages, BandResponse& band) noexcept
+{
+    std::array<SquaredMagnitudePolynomial, 4> numerators, denominators;
+    jassert(numStages <= (int) numerators.size());
+
+    for (size_t i = 0; i < (size_t) numStages; ++i)
+    {
+        const auto& b = stages[i];
+        numerators[i] = getPolynomial(b[0], b[1], b[2]);
+        denominators[i] = getPolynomial(1.0, b[3], b[4]);
+    }
+
+    for (size_t r = 0; r < sinSquared.size(); ++r)
+    {
+        auto s = sinSquared[r];
+        auto numerator = Register::expand(1.0);
+        auto denominator = Register::expand(1.0);
+
+        //c0 + s (c1 + s c2) for each stage, a whole register of frequencies at a time
+        for (size_t i = 0; i < (size_t) numStages; ++i)
+        {
+            const auto& n = numerators[i];
+            const auto& d = denominators[i];
+
+            numerator *= Register::multiplyAdd(Register::expand(n.c0), s, Register::multiplyAdd(Register::expand(n.c1), s, Register::expand(n.c2)));
+            denominator *= Register::multiplyAdd(Register::expand(d.c0), s, Register::multiplyAdd(Register::expand(d.c1), s, Register::expand(d.c2)));
+        }
+
+        band.numerator[r] = numerator;
+        band.denominator[r] = denominator;
+    }
+}
+
+void ResponseCurve::combine() noexcept
+{
+    for (size_t r = 0; r < sinSquared.size(); ++r)
+    {
+        auto numerator = bands[0].numerator[r] * bands[1].numerator[r] * bands[2].numerator[r];
+        auto denominator = bands[0].denominator[r] * bands[1].denominator[r] * bands[2].denominator[r];
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            auto index = r * numLanes + lane;
+
+            if (index >= decibels.size())
+                break;
+
+            auto power = numerator.get(lane) / juce::jmax(denominator.get(lane), std::numeric_limits<double>::min());
+            decibels[index] = juce::jmax(minDecibels, (float) (10.0 * std::log10(juce::jmax(power, 1.0e-30))));
+        }
+    }
+}
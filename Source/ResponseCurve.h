@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.h
+
+    Magnitude response of the 9 MonoChain biquads at one point per pixel.
+
+    Each band (low cut, peak, high cut) keeps its own response across the
+    width, so when one band changes only its stages are evaluated again and
+    the three are combined into the total curve.
+
+    A stage's squared magnitude is written as two polynomials in
+    s = sin^2(w / 2), which stays accurate at the low end where cos(w) is
+    almost 1. The polynomials are evaluated several frequencies at a time
+    with juce::dsp::SIMDRegister, in double because the product of four
+    steep cut sections underflows a float well inside the display range.
+    Only the final divide and log are scalar.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FilterCoefficients.h"
+#include "ParameterCache.h"
+
+class ResponseCurve
+{
+public:
+    using Register = juce::dsp::SIMDRegister<double>;
+
+    static constexpr size_t numLanes = Register::SIMDNumElements;
+
+    //the points are log spaced across this range, the same axis the spectrum analyzer uses
+    static constexpr float minFrequency = 20.f;
+    static constexpr float maxFrequency = 20000.f;
+
+    //message thread: sizes everything for a number of points and a design rate, every band starts flat
+    void prepare(int numPoints, double sampleRate);
+
+    int getNumPoints() const noexcept { return numPoints; }
+    double getSampleRate() const noexcept { return sampleRate; }
+
+    //re-evaluates the given ParameterCache bands of a set designed at the prepared rate, then the total
+    void update(const FilterCoefficientSet& coefficientSet, int bands) noexcept;
+
+    //total response of every band in dB, one value per point
+    const std::vector<float>& getDecibels() const noexcept { return decibels; }
+
+    static float getFrequencyForPoint(int index, int numPoints) noexcept;
+
+private:
+    //numerator and denominator of the band's squared magnitude, multiplied over its stages
+    struct BandResponse
+    {
+        std::vector<Register> numerator, denominator;
+    };
+
+    void evaluate(const BiquadCoefficients* stages, int numStages, BandResponse& band) noexcept;
+    void combine() noexcept;
+
+    int numPoints{ 0 };
+    double sampleRate{ 0 };
+
+    //s = sin^2(w / 2) for every point, padded to a whole number of registers
+    std::vector<Register> sinSquared;
+
+    std::array<BandResponse, 3> bands;
+    std::vector<float> decibels;
+};
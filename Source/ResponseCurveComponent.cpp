@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    ResponseCurveComponent.cpp
+
+  ==============================================================================
+*/
+
+#include "ResponseCurveComponent.h"
+
+ResponseCurveComponent::ResponseCurveComponent(SimpleEQAudioProcessor& processor)
+    : audioProcessor(processor),
+      parameters(processor.apvts)
+{
+    //sits over the analyzer, clicks go through to it
+    setInterceptsMouseClicks(false, false);
+
+    startTimerHz(updatesPerSecond);
+}
+
+ResponseCurveComponent::~ResponseCurveComponent()
+{
+    stopTimer();
+}
+
+double ResponseCurveComponent::getDesignSampleRate() const
+{
+    //before the host has prepared the processor there's no rate yet, show the curve at a typical one
+    auto hostSampleRate = audioProcessor.getSampleRate() > 0 ? audioProcessor.getSampleRate() : 48000.0;
+    return hostSampleRate * (1 << parameters.getOversamplingOrder());
+}
+
+void ResponseCurveComponent::resized()
+{
+    //a new width needs every band at the new points
+    updateCurve(ParameterCache::allBands);
+}
+
+void ResponseCurveComponent::timerCallback()
+{
+    //several parameter changes between two ticks only cost one redesign per band, and none costs nothing
+    updateCurve(parameters.consumeDirtyBands());
+}
+
+void ResponseCurveComponent::updateCurve(int bands)
+{
+    if (getWidth() <= 0)
+        return;
+
+    auto sampleRate = getDesignSampleRate();
+
+    if (getWidth() != responseCurve.getNumPoints() || sampleRate != responseCurve.getSampleRate())
+    {
+        responseCurve.prepare(getWidth(), sampleRate);
+        bands = ParameterCache::allBands;
+    }
+
+    if (bands == 0)
+        return;
+
+    //the same designs the processor runs, only for the bands that changed
+    //without oversampling the processor has usually designed them already, so they come from the cache
+    auto chainSettings = parameters.getChainSettings();
+    FilterCoefficientSet coefficientSet;
+
+    if (bands & ParameterCache::lowCutBand)
+    {
+        coefficientSet.lowCut = cache->getLowCutCoefficients(chainSettings, sampleRate);
+        coefficientSet.lowCutSlope = chainSettings.lowCutSlope;
+    }
+
+    if (bands & ParameterCache::peakBand)
+        coefficientSet.peak = cache->getPeakCoefficients(chainSettings, sampleRate);
+
+    if (bands & ParameterCache::highCutBand)
+    {
+        coefficientSet.highCut = cache->getHighCutCoefficients(chainSettings, sampleRate);
+        coefficientSet.highCutSlope = chainSettings.highCutSlope;
+    }
+
+    responseCurve.update(coefficientSet, bands);
+
+    updatePath();
+    repaint();
+}
+
+void ResponseCurveComponent::updatePath()
+{
+    const auto& decibels = responseCurve.getDecibels();
+    auto height = (float) getHeight();
+
+    auto getY = [height](float level)
+    {
+        return juce::jmap(juce::jlimit(-maxDisplayDecibels, maxDisplayDecibels, level),
+                          -maxDisplayDecibels, maxDisplayDecibels, height, 0.f);
+    };
+
+    //one point per pixel, so the path is only rebuilt when the curve itself changed
+    responsePath.clear();
+    responsePath.preallocateSpace((int) decibels.size() * 3);
+
+    for (size_t x = 0; x < decibels.size(); ++x)
+    {
+        if (x == 0)
+            responsePath.startNewSubPath(0.f, getY(decibels[x]));
+        else
+            responsePath.lineTo((float) x, getY(decibels[x]));
+    }
+}
+
+void ResponseCurveComponent::paint(juce::Graphics& g)
+{
+    g.setColour(juce::Colours::white);
+    g.strokePath(responsePath, juce::PathStrokeType(2.f));
+}
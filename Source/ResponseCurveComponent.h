@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    ResponseCurveComponent.h
+
+    Draws the combined response of the low cut, peak and high cut filters on
+    top of the spectrum analyzer.
+
+    A parameter change only flags its band in the component's own
+    ParameterCache, on whichever thread the host changed it from. The timer
+    picks the flags up on the message thread, redesigns and re-evaluates
+    only the flagged bands and rebuilds the path, and does nothing when none
+    are set. Painting just strokes the cached path.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "ResponseCurve.h"
+
+class ResponseCurveComponent : public juce::Component,
+                               private juce::Timer
+{
+public:
+    explicit ResponseCurveComponent(SimpleEQAudioProcessor& processor);
+    ~ResponseCurveComponent() override;
+
+    //gain range of the curve, top to bottom of the component
+    static constexpr float maxDisplayDecibels = 24.f;
+
+    static constexpr int updatesPerSecond = 60;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    void timerCallback() override;
+
+    //the rate the filters are designed for, including oversampling
+    double getDesignSampleRate() const;
+
+    //re-evaluates the bands, resizing the curve first if the width or the rate moved
+    void updateCurve(int bands);
+    void updatePath();
+
+    SimpleEQAudioProcessor& audioProcessor;
+
+    ResponseCurve responseCurve;
+    juce::Path responsePath;
+
+    //the designs every instance and editor share
+    juce::SharedResourcePointer<CoefficientCache> cache;
+
+    //declared last so it stops listening before the rest of the component is destroyed
+    ParameterCache parameters;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResponseCurveComponent)
+};
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    SimdCascade.cpp
+
+  ==============================================================================
+*/
+
+#include "SimdCascade.h"
+
+namespace
+{
+    //stage layout matches the MonoChain: low cut sections, peak, high cut sections
+    constexpr int firstLowCutStage = 0;
+    constexpr int peakStage = 4;
+    constexpr int firstHighCutStage = 5;
+}
+
+SimdCascade::SimdCascade()
+{
+    for (auto& stage : stages)
+    {
+        stage.b0 = Register::expand(1.f);
+        stage.b1 = Register::expand(0.f);
+        stage.b2 = Register::expand(0.f);
+        stage.a1 = Register::expand(0.f);
+        stage.a2 = Register::expand(0.f);
+    }
+
+    reset();
+}
+
+void SimdCascade::reset() noexcept
+{
+    for (size_t i = 0; i < (size_t) numStages; ++i)
+    {
+        state1[i] = Register::expand(0.f);
+        state2[i] = Register::expand(0.f);
+    }
+}
+
+void SimdCascade::resetLane(size_t lane) noexcept
+{
+    jassert(lane < numLanes);
+
+    for (size_t i = 0; i < (size_t) numStages; ++i)
+    {
+        state1[i].set(lane, 0.f);
+        state2[i].set(lane, 0.f);
+    }
+}
+
+void SimdCascade::setCoefficients(size_t lane, const FilterCoefficientSet& coefficientSet, int excludedBands) noexcept
+{
+    jassert(lane < numLanes);
+
+    auto numLowCutSections = (excludedBands & ParameterCache::lowCutBand) != 0 ? 0 : getNumCutSections(coefficientSet.lowCutSlope);
+    auto numHighCutSections = (excludedBands & ParameterCache::highCutBand) != 0 ? 0 : getNumCutSections(coefficientSet.highCutSlope);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        setStage(firstLowCutStage + i, lane, coefficientSet.lowCut[(size_t) i], i < numLowCutSections);
+        setStage(firstHighCutStage + i, lane, coefficientSet.highCut[(size_t) i], i < numHighCutSections);
+    }
+
+    setStage(peakStage, lane, coefficientSet.peak, true);
+
+    updateActiveStages();
+}
+
+void SimdCascade::setPeakCoefficients(size_t lane, const BiquadCoefficients& coefficients) noexcept
+{
+    jassert(lane < numLanes);
+
+    //the peak stage is always active, so the active stage list stays as it is
+    setStage(peakStage, lane, coefficients, true);
+}
+
+void SimdCascade::setStage(int stageIndex, size_t lane, const BiquadCoefficients& coefficients, bool isActive) noexcept
+{
+    auto& stage = stages[(size_t) stageIndex];
+    const auto& c = isActive ? coefficients : identityBiquad;
+
+    stage.b0.set(lane, (float) c[0]);
+    stage.b1.set(lane, (float) c[1]);
+    stage.b2.set(lane, (float) c[2]);
+    stage.a1.set(lane, (float) c[3]);
+    stage.a2.set(lane, (float) c[4]);
+
+    auto laneBit = (juce::uint32) 1 << lane;
+
+    if (isActive)
+        stageLanes[(size_t) stageIndex] |= laneBit;
+    else
+        stageLanes[(size_t) stageIndex] &= ~laneBit;
+}
+
+void SimdCascade::updateActiveStages() noexcept
+{
+    numActiveStages = 0;
+
+    for (int i = 0; i < numStages; ++i)
+        if (stageLanes[(size_t) i] != 0)
+            activeStages[(size_t) numActiveStages++] = i;
+}
+
+void SimdCascade::process(const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    auto numChannels = juce::jmin(block.getNumChannels(), numLanes);
+    auto numSamples = block.getNumSamples();
+
+    std::array<float*, numLanes> channels{};
+
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        channels[ch] = block.getChannelPointer(ch);
+
+    //unused lanes stay at zero so they never produce denormals
+    alignas (Register::SIMDRegisterSize) float frame[numLanes] = {};
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            frame[ch] = channels[ch][i];
+
+        auto x = Register::fromRawArray(frame);
+
+        //same transposed direct form II as juce::dsp::IIR::Filter
+        for (int s = 0; s < numActiveStages; ++s)
+        {
+            auto index = (size_t) activeStages[(size_t) s];
+            const auto& c = stages[index];
+            auto& s1 = state1[index];
+            auto& s2 = state2[index];
+
+            auto y = x * c.b0 + s1;
+            s1 = x * c.b1 - y * c.a1 + s2;
+            s2 = x * c.b2 - y * c.a2;
+            x = y;
+        }
+
+        x.copyToRawArray(frame);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            channels[ch][i] = frame[ch];
+    }
+}
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    SimdCascade.h
+
+    The 9 biquads of a MonoChain (4 low cut, 1 peak, 4 high cut) run for
+    several channels at once, one channel per SIMD lane.
+
+    juce::dsp::SIMDRegister picks SSE, AVX or NEON for the build, so a stereo
+    pair shares one register and each stage is a single vector multiply-add
+    chain instead of one scalar IIR::Filter per channel. The arithmetic is the
+    same transposed direct form II as IIR::Filter, so the output matches the
+    MonoChain path to within rounding.
+
+    Stages none of the lanes use are left out of the processing loop entirely.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FilterCoefficients.h"
+#include "ParameterCache.h"
+
+class SimdCascade
+{
+public:
+    using Register = juce::dsp::SIMDRegister<float>;
+
+    static constexpr size_t numLanes = Register::SIMDNumElements;
+    static constexpr int numStages = 9;
+
+    SimdCascade();
+
+    //clears the filter state of every lane
+    void reset() noexcept;
+
+    //clears the filter state of one lane
+    void resetLane(size_t lane) noexcept;
+
+    //gives one lane the coefficients of a designed set, lanes that don't use a stage pass it through
+    //the cut bands in excludedBands (ParameterCache band bits) pass through too, they're run somewhere else
+    void setCoefficients(size_t lane, const FilterCoefficientSet& coefficientSet, int excludedBands = 0) noexcept;
+
+    //gives one lane a new peak biquad and leaves the other stages alone, for gain-only updates
+    void setPeakCoefficients(size_t lane, const BiquadCoefficients& coefficients) noexcept;
+
+    //processes up to numLanes channels in place
+    void process(const juce::dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    struct Stage
+    {
+        Register b0, b1, b2, a1, a2;
+    };
+
+    void setStage(int stageIndex, size_t lane, const BiquadCoefficients& coefficients, bool isActive) noexcept;
+    void updateActiveStages() noexcept;
+
+    std::array<Stage, (size_t) numStages> stages;
+    std::array<Register, (size_t) numStages> state1, state2;
+
+    //which stages each lane needs, one bit per lane
+    std::array<juce::uint32, (size_t) numStages> stageLanes{};
+
+    //indices of the stages at least one lane needs, in processing order
+    std::array<int, (size_t) numStages> activeStages{};
+    int numActiveStages{ 0 };
+
+    JUCE_LEAK_DETECTOR (SimdCascade)
+};
@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+namespace
+{
+    //about 0.7 s of audio at 48 kHz, plenty for the worker to wake up in
+    constexpr int fifoSize = 1 << 15;
+
+    //how often the worker looks at the FIFOs, in ms
+    constexpr int activePollInterval = 5;
+    constexpr int idlePollInterval = 50;
+
+    //per hop, peaks show straight away and fall back over a few hundred ms
+    constexpr float releaseCoefficient = 0.8f;
+
+    //copies the sum of every channel, scaled down to the mono average
+    void mixDown(float* destination, const juce::dsp::AudioBlock<float>& block, size_t start, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        auto gain = 1.f / (float) block.getNumChannels();
+
+        juce::FloatVectorOperations::copyWithMultiply(destination, block.getChannelPointer(0) + start, gain, numSamples);
+
+        for (size_t ch = 1; ch < block.getNumChannels(); ++ch)
+            juce::FloatVectorOperations::addWithMultiply(destination, block.getChannelPointer(ch) + start, gain, numSamples);
+    }
+
+    //the same for double blocks, summed in double and rounded once
+    void mixDown(float* destination, const juce::dsp::AudioBlock<double>& block, size_t start, int numSamples) noexcept
+    {
+        auto gain = 1.0 / (double) block.getNumChannels();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto sum = 0.0;
+
+            for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+                sum += block.getChannelPointer(ch)[start + (size_t) i];
+
+            destination[i] = (float) (sum * gain);
+        }
+    }
+}
+
+SpectrumAnalyzerThread::SpectrumAnalyzerThread()
+    : juce::TimeSliceThread("SimpleEQ Spectrum Analyzer")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+SpectrumAnalyzerThread::~SpectrumAnalyzerThread()
+{
+    stopThread(1000);
+}
+
+//==============================================================================
+SpectrumAnalyzer::Channel::Channel()
+    : fifo(fifoSize),
+      fifoBuffer((size_t) fifoSize),
+      history((size_t) fftSize)
+{
+    reset();
+}
+
+template <typename SampleType>
+void SpectrumAnalyzer::Channel::push(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    if (block.getNumChannels() == 0)
+        return;
+
+    auto numSamples = juce::jmin((int) block.getNumSamples(), fifo.getFreeSpace());
+    auto scope = fifo.write(numSamples);
+
+    mixDown(fifoBuffer.data() + scope.startIndex1, block, 0, scope.blockSize1);
+    mixDown(fifoBuffer.data() + scope.startIndex2, block, (size_t) scope.blockSize1, scope.blockSize2);
+}
+
+template void SpectrumAnalyzer::Channel::push(const juce::dsp::AudioBlock<float>&) noexcept;
+template void SpectrumAnalyzer::Channel::push(const juce::dsp::AudioBlock<double>&) noexcept;
+
+void SpectrumAnalyzer::Channel::skipReady() noexcept
+{
+    fifo.read(fifo.getNumReady());
+}
+
+void SpectrumAnalyzer::Channel::reset() noexcept
+{
+    std::fill(history.begin(), history.end(), 0.f);
+    averaged.fill(0.f);
+    levels.fill(minDecibels);
+}
+
+//==============================================================================
+SpectrumAnalyzer::SpectrumAnalyzer()
+    : fftBuffer((size_t) fftSize * 2)
+{
+    frames.forEachBuffer([](Frame& frame)
+    {
+        frame.pre.fill(minDecibels);
+        frame.post.fill(minDecibels);
+    });
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    release();
+}
+
+void SpectrumAnalyzer::prepare(double sampleRate)
+{
+    //removing the client waits for a running time slice to finish, so the bins can be rebuilt after this
+    release();
+
+    auto binsPerHertz = (float) (fftSize / sampleRate);
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        auto low = getFrequencyForPoint(i) * std::pow(maxFrequency / minFrequency, -0.5f / (numPoints - 1));
+        auto high = getFrequencyForPoint(i) * std::pow(maxFrequency / minFrequency, 0.5f / (numPoints - 1));
+
+        auto& bins = pointBins[(size_t) i];
+        bins.first = juce::jlimit(0, hopSize, (int) std::ceil(low * binsPerHertz));
+        bins.last = juce::jlimit(0, hopSize, (int) std::floor(high * binsPerHertz));
+        bins.position = juce::jlimit(0.f, (float) hopSize, getFrequencyForPoint(i) * binsPerHertz);
+    }
+
+    needsReset = true;
+
+    thread->addTimeSliceClient(this);
+    isRegistered = true;
+}
+
+void SpectrumAnalyzer::release()
+{
+    if (isRegistered)
+    {
+        thread->removeTimeSliceClient(this);
+        isRegistered = false;
+    }
+}
+
+void SpectrumAnalyzer::setEnabled(bool shouldBeEnabled) noexcept
+{
+    //the FIFOs hold whatever was left when it was switched off, the worker throws that away first
+    if (shouldBeEnabled && ! enabled.exchange(true))
+        needsReset = true;
+    else if (! shouldBeEnabled)
+        enabled = false;
+}
+
+float SpectrumAnalyzer::getFrequencyForPoint(int index) noexcept
+{
+    return minFrequency * std::pow(maxFrequency / minFrequency, (float) index / (float) (numPoints - 1));
+}
+
+int SpectrumAnalyzer::useTimeSlice()
+{
+    if (! isEnabled())
+        return idlePollInterval;
+
+    if (needsReset.exchange(false))
+    {
+        for (auto* channel : { &pre, &post })
+        {
+            channel->skipReady();
+            channel->reset();
+        }
+    }
+
+    auto preUpdated = analyse(pre);
+    auto postUpdated = analyse(post);
+
+    if (! preUpdated && ! postUpdated)
+        return activePollInterval;
+
+    auto& frame = frames.getWriteBuffer();
+    frame.pre = pre.levels;
+    frame.post = post.levels;
+    frames.publish();
+
+    return activePollInterval;
+}
+
+bool SpectrumAnalyzer::analyse(Channel& channel) noexcept
+{
+    auto hasAnalysed = false;
+
+    while (channel.fifo.getNumReady() >= hopSize)
+    {
+        //slide the history along by a hop and append the new samples
+        std::copy(channel.history.begin() + hopSize, channel.history.end(), channel.history.begin());
+
+        {
+            auto scope = channel.fifo.read(hopSize);
+            auto* destination = channel.history.data() + (fftSize - hopSize);
+
+            std::copy_n(channel.fifoBuffer.data() + scope.startIndex1, scope.blockSize1, destination);
+            std::copy_n(channel.fifoBuffer.data() + scope.startIndex2, scope.blockSize2, destination + scope.blockSize1);
+        }
+
+        std::copy(channel.history.begin(), channel.history.end(), fftBuffer.begin());
+        window.multiplyWithWindowingTable(fftBuffer.data(), (size_t) fftSize);
+        fft.performFrequencyOnlyForwardTransform(fftBuffer.data(), true);
+
+        for (size_t bin = 0; bin < channel.averaged.size(); ++bin)
+        {
+            auto& average = channel.averaged[bin];
+            average = juce::jmax(fftBuffer[bin], average * releaseCoefficient);
+        }
+
+        hasAnalysed = true;
+    }
+
+    if (hasAnalysed)
+        updateLevels(channel);
+
+    return hasAnalysed;
+}
+
+void SpectrumAnalyzer::updateLevels(Channel& channel) const noexcept
+{
+    //a Hann window halves a sine's amplitude and the FFT scales it by N/2, so a full scale sine comes out at N/4
+    constexpr auto scale = 4.f / (float) fftSize;
+
+    for (size_t i = 0; i < pointBins.size(); ++i)
+    {
+        const auto& bins = pointBins[i];
+        float magnitude;
+
+        if (bins.last >= bins.first)
+        {
+            //the loudest bin in the point's share of the axis
+            magnitude = *std::max_element(channel.averaged.begin() + bins.first, channel.averaged.begin() + bins.last + 1);
+        }
+        else
+        {
+            //down low the points are closer together than the bins, interpolate between the two either side
+            auto index = juce::jmin((int) bins.position, hopSize - 1);
+            auto fraction = bins.position - (float) index;
+            magnitude = channel.averaged[(size_t) index] + fraction * (channel.averaged[(size_t) index + 1] - channel.averaged[(size_t) index]);
+        }
+
+        channel.levels[i] = juce::Decibels::gainToDecibels(magnitude * scale, minDecibels);
+    }
+}
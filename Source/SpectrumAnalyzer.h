@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+
+    Pre and post EQ spectrum for the editor.
+
+    The audio thread only mixes each block down to mono and copies it into a
+    wait-free single producer, single consumer FIFO, one for the input and
+    one for the output. While the analyzer is switched off (no editor open)
+    it doesn't even do that.
+
+    A worker shared by every instance drains the FIFOs in hops of half an
+    FFT, runs a Hann windowed FFT, averages the magnitudes over time and
+    bins them onto log spaced display points. The levels are published
+    through a TripleBuffer, so the editor just picks up the newest frame
+    when it repaints.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TripleBuffer.h"
+
+//one worker shared by every instance in the process, separate from the coefficient designer so
+//the FFTs never hold up a parameter change
+struct SpectrumAnalyzerThread : public juce::TimeSliceThread
+{
+    SpectrumAnalyzerThread();
+    ~SpectrumAnalyzerThread() override;
+};
+
+class SpectrumAnalyzer : private juce::TimeSliceClient
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 2;
+
+    //display points, log spaced from minFrequency to maxFrequency
+    static constexpr int numPoints = 256;
+    static constexpr float minFrequency = 20.f;
+    static constexpr float maxFrequency = 20000.f;
+
+    //levels are clamped to this, a full scale sine reads 0 dB
+    static constexpr float minDecibels = -100.f;
+
+    struct Frame
+    {
+        std::array<float, numPoints> pre;
+        std::array<float, numPoints> post;
+    };
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer() override;
+
+    //message thread: works out the bins for the new rate and starts the worker on it
+    void prepare(double sampleRate);
+
+    //message thread: takes the analyzer off the worker until the next prepare
+    void release();
+
+    //any thread: the editor switches the analyzer on while it's showing, the audio thread skips it otherwise
+    void setEnabled(bool shouldBeEnabled) noexcept;
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    //audio thread: copies the block into the input or output FIFO, drops it if the worker fell behind
+    //double blocks are rounded to float on the way in, the analysis is float either way
+    template <typename SampleType>
+    void pushPre(const juce::dsp::AudioBlock<SampleType>& block) noexcept   { if (isEnabled()) pre.push(block); }
+
+    template <typename SampleType>
+    void pushPost(const juce::dsp::AudioBlock<SampleType>& block) noexcept  { if (isEnabled()) post.push(block); }
+
+    //message thread: the newest frame, or nullptr if nothing was published since the last call
+    const Frame* acquireFrame() noexcept { return frames.acquire(); }
+
+    //message thread: the frame the last acquireFrame returned
+    const Frame& getLastFrame() const noexcept { return frames.getReadBuffer(); }
+
+    static float getFrequencyForPoint(int index) noexcept;
+
+private:
+    //a FIFO and the analysis state for one side of the EQ
+    struct Channel
+    {
+        Channel();
+
+        template <typename SampleType>
+        void push(const juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+        //drops whatever the audio thread left in the FIFO before the analyzer was switched off
+        void skipReady() noexcept;
+
+        void reset() noexcept;
+
+        juce::AbstractFifo fifo;
+        std::vector<float> fifoBuffer;
+
+        std::vector<float> history;                 //the last fftSize samples
+        std::array<float, hopSize + 1> averaged;    //smoothed magnitude per bin
+        std::array<float, numPoints> levels;        //averaged bins at the display points, in dB
+    };
+
+    //the bins a display point covers, or an interpolation position for points closer together than the bins
+    struct PointBins
+    {
+        int first{ 0 };
+        int last{ 0 };
+        float position{ 0 };
+    };
+
+    int useTimeSlice() override;
+
+    //runs every complete hop waiting in the FIFO, false if there wasn't one
+    bool analyse(Channel& channel) noexcept;
+    void updateLevels(Channel& channel) const noexcept;
+
+    Channel pre, post;
+    std::atomic<bool> enabled{ false };
+    std::atomic<bool> needsReset{ true };
+
+    juce::dsp::FFT fft{ fftOrder };
+    juce::dsp::WindowingFunction<float> window{ (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> fftBuffer;
+
+    std::array<PointBins, numPoints> pointBins;
+
+    TripleBuffer<Frame> frames;
+
+    juce::SharedResourcePointer<SpectrumAnalyzerThread> thread;
+    bool isRegistered{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzer)
+};
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzerComponent.cpp
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzerComponent.h"
+
+SpectrumAnalyzerComponent::SpectrumAnalyzerComponent(SpectrumAnalyzer& spectrumAnalyzer)
+    : analyzer(spectrumAnalyzer)
+{
+    setOpaque(true);
+
+    //enough for a point per display point, so building the paths never reallocates
+    for (auto* path : { &prePath, &postPath })
+        path->preallocateSpace(SpectrumAnalyzer::numPoints * 3 + 8);
+
+    analyzer.setEnabled(true);
+    startTimerHz(maxFramesPerSecond);
+}
+
+SpectrumAnalyzerComponent::~SpectrumAnalyzerComponent()
+{
+    stopTimer();
+    analyzer.setEnabled(false);
+}
+
+float SpectrumAnalyzerComponent::getXForFrequency(float frequency, float width) noexcept
+{
+    return width * juce::mapFromLog10(frequency, SpectrumAnalyzer::minFrequency, SpectrumAnalyzer::maxFrequency);
+}
+
+void SpectrumAnalyzerComponent::timerCallback()
+{
+    //the worker only publishes when a hop of audio came through, otherwise there's nothing to redraw
+    if (auto* frame = analyzer.acquireFrame())
+    {
+        updatePath(prePath, frame->pre);
+        updatePath(postPath, frame->post);
+        repaint();
+    }
+}
+
+void SpectrumAnalyzerComponent::resized()
+{
+    //the paths are in pixels, rebuild them for the new size from the last frame
+    const auto& frame = analyzer.getLastFrame();
+    updatePath(prePath, frame.pre);
+    updatePath(postPath, frame.post);
+}
+
+void SpectrumAnalyzerComponent::updatePath(juce::Path& path, const std::array<float, SpectrumAnalyzer::numPoints>& levels) const
+{
+    auto width = (float) getWidth();
+    auto height = (float) getHeight();
+
+    auto getY = [height](float level)
+    {
+        return juce::jmap(juce::jlimit(minDisplayDecibels, maxDisplayDecibels, level),
+                          minDisplayDecibels, maxDisplayDecibels, height, 0.f);
+    };
+
+    //the points are log spaced already, so they sit evenly across the width
+    path.clear();
+    path.startNewSubPath(0.f, height);
+
+    for (int i = 0; i < SpectrumAnalyzer::numPoints; ++i)
+        path.lineTo(width * (float) i / (float) (SpectrumAnalyzer::numPoints - 1), getY(levels[(size_t) i]));
+
+    path.lineTo(width, height);
+    path.closeSubPath();
+}
+
+void SpectrumAnalyzerComponent::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    drawGrid(g);
+
+    g.setColour(juce::Colours::skyblue.withAlpha(0.25f));
+    g.fillPath(prePath);
+
+    g.setColour(juce::Colours::orange.withAlpha(0.35f));
+    g.fillPath(postPath);
+
+    g.setColour(juce::Colours::orange);
+    g.strokePath(postPath, juce::PathStrokeType(1.f));
+}
+
+void SpectrumAnalyzerComponent::drawGrid(juce::Graphics& g) const
+{
+    auto width = (float) getWidth();
+    auto height = (float) getHeight();
+
+    g.setFont(juce::FontOptions(10.f));
+
+    for (auto frequency : { 50.f, 100.f, 200.f, 500.f, 1000.f, 2000.f, 5000.f, 10000.f })
+    {
+        auto x = getXForFrequency(frequency, width);
+
+        g.setColour(juce::Colours::dimgrey);
+        g.drawVerticalLine(juce::roundToInt(x), 0.f, height);
+
+        g.setColour(juce::Colours::lightgrey);
+        g.drawText(frequency >= 1000.f ? juce::String(frequency / 1000.f) + "k" : juce::String(frequency),
+                   juce::roundToInt(x) + 2, (int) height - 14, 40, 12, juce::Justification::left);
+    }
+
+    for (auto level = maxDisplayDecibels; level > minDisplayDecibels; level -= 12.f)
+    {
+        auto y = juce::jmap(level, minDisplayDecibels, maxDisplayDecibels, height, 0.f);
+
+        g.setColour(level == 0.f ? juce::Colours::grey : juce::Colours::dimgrey.withAlpha(0.6f));
+        g.drawHorizontalLine(juce::roundToInt(y), 0.f, width);
+
+        g.setColour(juce::Colours::lightgrey);
+        g.drawText(juce::String(juce::roundToInt(level)) + " dB", 2, juce::roundToInt(y) + 1, 50, 12, juce::Justification::left);
+    }
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzerComponent.h
+
+    Draws the pre and post EQ spectrum from the frames the SpectrumAnalyzer
+    publishes. A timer polls for a new frame at up to maxFramesPerSecond and
+    the component only repaints when one has arrived, so a silent or stopped
+    analyzer costs nothing to draw.
+
+    The analyzer is switched on for as long as the component exists.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SpectrumAnalyzer.h"
+
+class SpectrumAnalyzerComponent : public juce::Component,
+                                  private juce::Timer
+{
+public:
+    explicit SpectrumAnalyzerComponent(SpectrumAnalyzer& analyzer);
+    ~SpectrumAnalyzerComponent() override;
+
+    static constexpr int maxFramesPerSecond = 30;
+
+    //level range of the display, anything outside is clamped to the edges
+    static constexpr float minDisplayDecibels = -96.f;
+    static constexpr float maxDisplayDecibels = 12.f;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    //position of a frequency along the log axis the analyzer's points are spaced on
+    static float getXForFrequency(float frequency, float width) noexcept;
+
+private:
+    void timerCallback() override;
+
+    //rebuilds a path in place, the paths keep their storage between frames
+    void updatePath(juce::Path& path, const std::array<float, SpectrumAnalyzer::numPoints>& levels) const;
+
+    void drawGrid(juce::Graphics& g) const;
+
+    SpectrumAnalyzer& analyzer;
+    juce::Path prePath, postPath;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzerComponent)
+};
@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+    StateSerialization.cpp
+
+  ==============================================================================
+*/
+
+#include "StateSerialization.h"
+
+namespace StateSerialization
+{
+namespace
+{
+    constexpr size_t headerSize = 8;
+    constexpr size_t entrySize = 8;
+    constexpr size_t checksumSize = 4;
+
+    //one entry per reflected byte value of the 0xEDB88320 polynomial
+    constexpr std::array<juce::uint32, 256> makeChecksumTable() noexcept
+    {
+        std::array<juce::uint32, 256> table{};
+
+        for (juce::uint32 i = 0; i < 256; ++i)
+        {
+            auto value = i;
+
+            for (int bit = 0; bit < 8; ++bit)
+                value = (value & 1) != 0 ? 0xedb88320u ^ (value >> 1) : value >> 1;
+
+            table[i] = value;
+        }
+
+        return table;
+    }
+
+    constexpr auto checksumTable = makeChecksumTable();
+
+    void writeUint32(juce::uint8* destination, juce::uint32 value) noexcept
+    {
+        value = juce::ByteOrder::swapIfBigEndian(value);
+        std::memcpy(destination, &value, sizeof(value));
+    }
+
+    void writeUint16(juce::uint8* destination, juce::uint16 value) noexcept
+    {
+        value = juce::ByteOrder::swapIfBigEndian(value);
+        std::memcpy(destination, &value, sizeof(value));
+    }
+
+    juce::uint32 readUint32(const juce::uint8* source) noexcept
+    {
+        juce::uint32 value;
+        std::memcpy(&value, source, sizeof(value));
+        return juce::ByteOrder::swapIfBigEndian(value);
+    }
+
+    juce::uint16 readUint16(const juce::uint8* source) noexcept
+    {
+        juce::uint16 value;
+        std::memcpy(&value, source, sizeof(value));
+        return juce::ByteOrder::swapIfBigEndian(value);
+    }
+
+    //the processor's parameters that have IDs, in the order the processor keeps them
+    template <typename Function>
+    void forEachRangedParameter(juce::AudioProcessor& processor, Function&& function)
+    {
+        for (auto* parameter : processor.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+                function(*ranged);
+    }
+
+    void setIfChanged(juce::RangedAudioParameter& parameter, float normalisedValue)
+    {
+        //only the parameters that actually move notify the host and the listeners
+        if (parameter.getValue() != normalisedValue)
+            parameter.setValueNotifyingHost(normalisedValue);
+    }
+}
+
+juce::uint32 getParameterIDHash(const juce::String& parameterID) noexcept
+{
+    juce::uint32 hash = 2166136261u;
+
+    for (auto* character = parameterID.toRawUTF8(); *character != 0; ++character)
+    {
+        hash ^= (juce::uint8) *character;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+juce::uint32 getChecksum(const void* data, size_t numBytes) noexcept
+{
+    auto crc = 0xffffffffu;
+    auto* bytes = static_cast<const juce::uint8*>(data);
+
+    for (size_t i = 0; i < numBytes; ++i)
+        crc = checksumTable[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+
+    return crc ^ 0xffffffffu;
+}
+
+//==============================================================================
+void writeBinary(juce::AudioProcessor& processor, juce::MemoryBlock& destination)
+{
+    size_t numEntries = 0;
+    forEachRangedParameter(processor, [&numEntries](juce::RangedAudioParameter&) { ++numEntries; });
+
+    destination.setSize(headerSize + numEntries * entrySize + checksumSize);
+    auto* bytes = static_cast<juce::uint8*>(destination.getData());
+
+    writeUint32(bytes, magic);
+    writeUint16(bytes + 4, (juce::uint16) currentVersion);
+    writeUint16(bytes + 6, (juce::uint16) numEntries);
+
+    auto* entry = bytes + headerSize;
+
+    forEachRangedParameter(processor, [&entry](juce::RangedAudioParameter& parameter)
+    {
+        auto value = parameter.convertFrom0to1(parameter.getValue());
+
+        juce::uint32 valueBits;
+        std::memcpy(&valueBits, &value, sizeof(valueBits));
+
+        writeUint32(entry, getParameterIDHash(parameter.getParameterID()));
+        writeUint32(entry + 4, valueBits);
+        entry += entrySize;
+    });
+
+    writeUint32(entry, getChecksum(bytes, (size_t) (entry - bytes)));
+}
+
+void writeXml(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& destination)
+{
+    if (auto xml = apvts.copyState().createXml())
+        juce::AudioProcessor::copyXmlToBinary(*xml, destination);
+}
+
+Format detectFormat(const void* data, int sizeInBytes) noexcept
+{
+    if (data == nullptr || sizeInBytes < 4)
+        return Format::unknown;
+
+    //copyXmlToBinary starts its blocks with this magic number
+    constexpr juce::uint32 xmlMagic = 0x21324356;
+
+    auto leadingWord = readUint32(static_cast<const juce::uint8*>(data));
+
+    if (leadingWord == magic)
+        return Format::binary;
+
+    if (leadingWord == xmlMagic)
+        return Format::xml;
+
+    return Format::unknown;
+}
+
+bool readBinary(juce::AudioProcessor& processor, const void* data, int sizeInBytes)
+{
+    auto* bytes = static_cast<const juce::uint8*>(data);
+    auto size = (size_t) juce::jmax(0, sizeInBytes);
+
+    if (size < headerSize + checksumSize || readUint32(bytes) != magic)
+        return false;
+
+    //an older reader can't know what a newer version changed, so it leaves the parameters alone
+    if (readUint16(bytes + 4) > currentVersion)
+        return false;
+
+    auto numEntries = (size_t) readUint16(bytes + 6);
+
+    if (size != headerSize + numEntries * entrySize + checksumSize
+        || readUint32(bytes + size - checksumSize) != getChecksum(bytes, size - checksumSize))
+        return false;
+
+    const auto* entries = bytes + headerSize;
+
+    forEachRangedParameter(processor, [&](juce::RangedAudioParameter& parameter)
+    {
+        auto hash = getParameterIDHash(parameter.getParameterID());
+        auto normalisedValue = parameter.getDefaultValue();
+
+        for (size_t i = 0; i < numEntries; ++i)
+        {
+            const auto* entry = entries + i * entrySize;
+
+            if (readUint32(entry) == hash)
+            {
+                auto valueBits = readUint32(entry + 4);
+                float value;
+                std::memcpy(&value, &valueBits, sizeof(value));
+
+                normalisedValue = parameter.convertTo0to1(value);
+                break;
+            }
+        }
+
+        setIfChanged(parameter, normalisedValue);
+    });
+
+    return true;
+}
+
+bool readXml(juce::AudioProcessorValueTreeState& apvts, const void* data, int sizeInBytes)
+{
+    auto xml = juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes);
+
+    if (xml == nullptr || ! xml->hasTagName(apvts.state.getType()))
+        return false;
+
+    apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    return true;
+}
+}
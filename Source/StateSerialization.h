@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    StateSerialization.h
+
+    Plugin state as a small binary block instead of the APVTS XML.
+
+        uint32  magic "SEQS"
+        uint16  version
+        uint16  number of entries
+        entries of { uint32 parameter ID hash, float32 value in parameter units }
+        uint32  CRC-32 of everything before it
+
+    Everything is little endian. Values are stored in the parameter's own
+    units rather than normalised, so a preset survives a range change, and
+    parameters are matched by a hash of their ID, so adding or removing one
+    doesn't break old states. Parameters missing from a state go back to
+    their defaults and entries nobody knows are skipped.
+
+    A damaged block, or one from a newer version, is rejected without
+    touching any parameter.
+
+    The XML written by copyXmlToBinary is still read, and written instead
+    of the binary block when SIMPLEEQ_XML_STATE=1, which is handy when a
+    state needs to be read by eye.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef SIMPLEEQ_XML_STATE
+ #define SIMPLEEQ_XML_STATE 0
+#endif
+
+namespace StateSerialization
+{
+    constexpr juce::uint32 magic = 0x53514553;     //"SEQS" once written little endian
+    constexpr int currentVersion = 1;
+
+    enum class Format
+    {
+        binary,
+        xml,
+        unknown
+    };
+
+    //message thread: every parameter of the processor with its current value
+    void writeBinary(juce::AudioProcessor& processor, juce::MemoryBlock& destination);
+    void writeXml(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& destination);
+
+    Format detectFormat(const void* data, int sizeInBytes) noexcept;
+
+    //message thread: sets every parameter whose value differs from the state, false if the block was rejected
+    bool readBinary(juce::AudioProcessor& processor, const void* data, int sizeInBytes);
+    bool readXml(juce::AudioProcessorValueTreeState& apvts, const void* data, int sizeInBytes);
+
+    //FNV-1a of the UTF-8 ID, stable across builds and platforms unlike String::hashCode
+    juce::uint32 getParameterIDHash(const juce::String& parameterID) noexcept;
+
+    //standard CRC-32, the same value zlib gives
+    juce::uint32 getChecksum(const void* data, size_t numBytes) noexcept;
+}
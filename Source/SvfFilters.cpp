@@ -0,0 +1,293 @@
+/*
+  ==============================================================================
+
+    SvfFilters.cpp
+
+  ==============================================================================
+*/
+
+#include "SvfFilters.h"
+#include "FilterCoefficients.h"
+
+namespace
+{
+    //integrator gain with the same prewarping the biquad designs use, so the cutoff lands in the same place
+    template <typename SampleType>
+    SampleType getIntegratorGain(SampleType frequency, double sampleRate) noexcept
+    {
+        return static_cast<SampleType>(std::tan(juce::MathConstants<double>::pi * (double) frequency / sampleRate));
+    }
+
+    //A of the RBJ peak, the square root of the linear gain
+    template <typename SampleType>
+    SampleType getPeakAmplitude(SampleType gainInDecibels) noexcept
+    {
+        return static_cast<SampleType>(std::pow(10.0, (double) gainInDecibels / 40.0));
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void SvfCutFilter<SampleType>::prepare(const juce::dsp::ProcessSpec& spec) noexcept
+{
+    jassert(spec.numChannels == 1);
+
+    sampleRate = spec.sampleRate;
+    g.reset(sampleRate, rampLengthSeconds);
+
+    setCurrentAndTarget(targetFrequency, static_cast<Slope>(numSections - 1));
+    reset();
+}
+
+template <typename SampleType>
+void SvfCutFilter<SampleType>::reset() noexcept
+{
+    for (auto& section : sections)
+        section.ic1eq = section.ic2eq = 0;
+}
+
+template <typename SampleType>
+void SvfCutFilter<SampleType>::setRampLength(double seconds) noexcept
+{
+    if (seconds == rampLengthSeconds)
+        return;
+
+    //resetting the ramp jumps it to its target
+    rampLengthSeconds = seconds;
+    g.reset(sampleRate, rampLengthSeconds);
+    updateSections(g.getCurrentValue());
+}
+
+template <typename SampleType>
+void SvfCutFilter<SampleType>::setTarget(SampleType frequency, Slope slope) noexcept
+{
+    auto slopeChanged = getNumCutSections(slope) != numSections;
+    auto frequencyChanged = frequency != targetFrequency;
+
+    if (slopeChanged)
+        setSlope(slope);
+
+    if (frequencyChanged)
+    {
+        targetFrequency = frequency;
+        g.setTargetValue(getIntegratorGain(targetFrequency, sampleRate));
+    }
+
+    //while ramping process() keeps the sections up to date, otherwise do it once here
+    if ((slopeChanged || frequencyChanged) && ! g.isSmoothing())
+        updateSections(g.getCurrentValue());
+}
+
+template <typename SampleType>
+void SvfCutFilter<SampleType>::setCurrentAndTarget(SampleType frequency, Slope slope) noexcept
+{
+    setSlope(slope);
+
+    targetFrequency = frequency;
+    g.setCurrentAndTargetValue(getIntegratorGain(targetFrequency, sampleRate));
+
+    updateSections(g.getCurrentValue());
+}
+
+template <typename SampleType>
+void SvfCutFilter<SampleType>::setSlope(Slope slope) noexcept
+{
+    auto newNumSections = getNumCutSections(slope);
+
+    //sections that come in start from silence, the ones already running keep their state
+    for (auto i = numSections; i < newNumSections; ++i)
+        sections[(size_t) i].ic1eq = sections[(size_t) i].ic2eq = 0;
+
+    numSections = newNumSections;
+
+    for (int i = 0; i < numSections; ++i)
+        sections[(size_t) i].k = static_cast<SampleType>(1.0 / getButterworthQuality(numSections, i));
+}
+
+template <typename SampleType>
+void SvfCutFilter<SampleType>::updateSections(SampleType newG) noexcept
+{
+    for (int i = 0; i < numSections; ++i)
+    {
+        auto& section = sections[(size_t) i];
+
+        section.a1 = SampleType(1) / (SampleType(1) + newG * (newG + section.k));
+        section.a2 = newG * section.a1;
+        section.a3 = newG * section.a2;
+    }
+}
+
+template <typename SampleType>
+void SvfCutFilter<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept
+{
+    //the ProcessorChain bypasses a slot through the context, the block is left as it is
+    if (context.isBypassed)
+        return;
+
+    auto block = context.getOutputBlock();
+    jassert(block.getNumChannels() == 1);
+
+    if (type == Type::lowCut)
+        processSamples<true>(block.getChannelPointer(0), block.getNumSamples());
+    else
+        processSamples<false>(block.getChannelPointer(0), block.getNumSamples());
+}
+
+template <typename SampleType>
+template <bool isHighPass>
+void SvfCutFilter<SampleType>::processSamples(SampleType* samples, size_t numSamples) noexcept
+{
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        //a moving cutoff costs one divide per section and sample, nothing is redesigned
+        if (g.isSmoothing())
+            updateSections(g.getNextValue());
+
+        auto x = samples[i];
+
+        for (int s = 0; s < numSections; ++s)
+        {
+            auto& section = sections[(size_t) s];
+
+            auto v3 = x - section.ic2eq;
+            auto v1 = section.a1 * section.ic1eq + section.a2 * v3;
+            auto v2 = section.ic2eq + section.a2 * section.ic1eq + section.a3 * v3;
+
+            section.ic1eq = SampleType(2) * v1 - section.ic1eq;
+            section.ic2eq = SampleType(2) * v2 - section.ic2eq;
+
+            if constexpr (isHighPass)
+                x = x - section.k * v1 - v2;
+            else
+                x = v2;
+        }
+
+        samples[i] = x;
+    }
+}
+
+template class SvfCutFilter<float>;
+template class SvfCutFilter<double>;
+
+//==============================================================================
+template <typename SampleType>
+void SvfPeakFilter<SampleType>::prepare(const juce::dsp::ProcessSpec& spec) noexcept
+{
+    jassert(spec.numChannels == 1);
+
+    sampleRate = spec.sampleRate;
+
+    g.reset(sampleRate, rampLengthSeconds);
+    quality.reset(sampleRate, rampLengthSeconds);
+    a.reset(sampleRate, rampLengthSeconds);
+
+    setCurrentAndTarget(targetFrequency, targetQuality, targetGainInDecibels);
+    reset();
+}
+
+template <typename SampleType>
+void SvfPeakFilter<SampleType>::reset() noexcept
+{
+    ic1eq = ic2eq = 0;
+}
+
+template <typename SampleType>
+void SvfPeakFilter<SampleType>::setRampLength(double seconds) noexcept
+{
+    if (seconds == rampLengthSeconds)
+        return;
+
+    rampLengthSeconds = seconds;
+
+    g.reset(sampleRate, rampLengthSeconds);
+    quality.reset(sampleRate, rampLengthSeconds);
+    a.reset(sampleRate, rampLengthSeconds);
+
+    update(g.getCurrentValue(), quality.getCurrentValue(), a.getCurrentValue());
+}
+
+template <typename SampleType>
+void SvfPeakFilter<SampleType>::setTarget(SampleType frequency, SampleType newQuality, SampleType gainInDecibels) noexcept
+{
+    if (frequency == targetFrequency && newQuality == targetQuality && gainInDecibels == targetGainInDecibels)
+        return;
+
+    if (frequency != targetFrequency)
+    {
+        targetFrequency = frequency;
+        g.setTargetValue(getIntegratorGain(targetFrequency, sampleRate));
+    }
+
+    if (newQuality != targetQuality)
+    {
+        targetQuality = newQuality;
+        quality.setTargetValue(targetQuality);
+    }
+
+    if (gainInDecibels != targetGainInDecibels)
+    {
+        targetGainInDecibels = gainInDecibels;
+        a.setTargetValue(getPeakAmplitude(targetGainInDecibels));
+    }
+
+    if (! isRamping())
+        update(g.getCurrentValue(), quality.getCurrentValue(), a.getCurrentValue());
+}
+
+template <typename SampleType>
+void SvfPeakFilter<SampleType>::setCurrentAndTarget(SampleType frequency, SampleType newQuality, SampleType gainInDecibels) noexcept
+{
+    targetFrequency = frequency;
+    targetQuality = newQuality;
+    targetGainInDecibels = gainInDecibels;
+
+    g.setCurrentAndTargetValue(getIntegratorGain(targetFrequency, sampleRate));
+    quality.setCurrentAndTargetValue(targetQuality);
+    a.setCurrentAndTargetValue(getPeakAmplitude(targetGainInDecibels));
+
+    update(g.getCurrentValue(), quality.getCurrentValue(), a.getCurrentValue());
+}
+
+template <typename SampleType>
+void SvfPeakFilter<SampleType>::update(SampleType newG, SampleType newQuality, SampleType newA) noexcept
+{
+    //k = 1 / (Q * A) gives the RBJ peak's bandwidth for both boost and cut
+    k = SampleType(1) / (newQuality * newA);
+    m1 = k * (newA * newA - SampleType(1));
+
+    a1 = SampleType(1) / (SampleType(1) + newG * (newG + k));
+    a2 = newG * a1;
+    a3 = newG * a2;
+}
+
+template <typename SampleType>
+void SvfPeakFilter<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept
+{
+    if (context.isBypassed)
+        return;
+
+    auto block = context.getOutputBlock();
+    jassert(block.getNumChannels() == 1);
+
+    auto* samples = block.getChannelPointer(0);
+
+    for (size_t i = 0; i < block.getNumSamples(); ++i)
+    {
+        if (isRamping())
+            update(g.getNextValue(), quality.getNextValue(), a.getNextValue());
+
+        auto x = samples[i];
+
+        auto v3 = x - ic2eq;
+        auto v1 = a1 * ic1eq + a2 * v3;
+        auto v2 = ic2eq + a2 * ic1eq + a3 * v3;
+
+        ic1eq = SampleType(2) * v1 - ic1eq;
+        ic2eq = SampleType(2) * v2 - ic2eq;
+
+        samples[i] = x + m1 * v1;
+    }
+}
+
+template class SvfPeakFilter<float>;
+template class SvfPeakFilter<double>;
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    SvfFilters.h
+
+    Topology preserving transform (TPT) state variable filters that take the
+    place of the CutFilter and peak Filter slots of a MonoChain.
+
+    Each second order section is the trapezoidal SVF from Andrew Simper's
+    "Linear Trap Optimised SVF" paper. It is the same bilinear transform with
+    prewarping as the biquads FilterCoefficients designs, so the magnitude
+    response matches for every Slope. The difference is that the state is
+    held as integrator charges, which stay meaningful when the coefficients
+    change, so the cutoff can move every sample without clicks or blowing up.
+
+    Moving the cutoff doesn't need a redesign. Every section of a Butterworth
+    cut shares g = tan(pi * fc / fs), so the filter ramps g itself and each
+    section only works out its three gains again, one divide per section.
+    The peak ramps g, Q and the linear gain A the same way.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ChainSettings.h"
+
+//a Butterworth low or high cut of 1 to 4 sections, one per 12 dB/Oct
+template <typename SampleType>
+class SvfCutFilter
+{
+public:
+    enum class Type
+    {
+        lowCut,     //high pass
+        highCut     //low pass
+    };
+
+    void setType(Type newType) noexcept { type = newType; }
+
+    //the chain is mono, only the sample rate is used, the ramp keeps its length and the cutoff its target
+    void prepare(const juce::dsp::ProcessSpec& spec) noexcept;
+    void reset() noexcept;
+
+    //0 jumps to every new target straight away
+    void setRampLength(double seconds) noexcept;
+
+    //audio thread: ramps the cutoff to a new frequency, a new slope applies straight away
+    void setTarget(SampleType frequency, Slope slope) noexcept;
+
+    //audio thread: jumps to a cutoff and slope without ramping
+    void setCurrentAndTarget(SampleType frequency, Slope slope) noexcept;
+
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept;
+
+private:
+    struct Section
+    {
+        SampleType k{ 0 };                          //1 / Q
+        SampleType a1{ 0 }, a2{ 0 }, a3{ 0 };
+        SampleType ic1eq{ 0 }, ic2eq{ 0 };          //integrator states
+    };
+
+    void setSlope(Slope slope) noexcept;
+    void updateSections(SampleType g) noexcept;
+
+    template <bool isHighPass>
+    void processSamples(SampleType* samples, size_t numSamples) noexcept;
+
+    std::array<Section, 4> sections;
+    int numSections{ 1 };
+    Type type{ Type::lowCut };
+
+    double sampleRate{ 44100 };
+    double rampLengthSeconds{ 0 };
+    SampleType targetFrequency{ 1000 };
+
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative> g;
+};
+
+//the RBJ peak as an SVF bell: the input plus the band pass output scaled by k * (A^2 - 1)
+template <typename SampleType>
+class SvfPeakFilter
+{
+public:
+    void prepare(const juce::dsp::ProcessSpec& spec) noexcept;
+    void reset() noexcept;
+
+    void setRampLength(double seconds) noexcept;
+
+    //audio thread: ramps towards new settings, the gain ramps linearly in dB like the ParameterSmoother does
+    void setTarget(SampleType frequency, SampleType quality, SampleType gainInDecibels) noexcept;
+    void setCurrentAndTarget(SampleType frequency, SampleType quality, SampleType gainInDecibels) noexcept;
+
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept;
+
+private:
+    bool isRamping() const noexcept { return g.isSmoothing() || quality.isSmoothing() || a.isSmoothing(); }
+    void update(SampleType newG, SampleType newQuality, SampleType newA) noexcept;
+
+    SampleType k{ 0 }, m1{ 0 };
+    SampleType a1{ 0 }, a2{ 0 }, a3{ 0 };
+    SampleType ic1eq{ 0 }, ic2eq{ 0 };
+
+    double sampleRate{ 44100 };
+    double rampLengthSeconds{ 0 };
+    SampleType targetFrequency{ 1000 }, targetQuality{ 1 }, targetGainInDecibels{ 0 };
+
+    //a multiplicative ramp of A = 10^(dB / 40) is a linear ramp in dB
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative> g, quality, a;
+};
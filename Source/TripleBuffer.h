@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+
+    Wait-free hand-off of a value from one writer thread to one reader thread.
+
+    The writer fills the back buffer and publishes it, the reader picks up the
+    newest published buffer. Neither side ever blocks or allocates, and the
+    reader always sees a complete value because the two sides never share a
+    buffer. Values published while the reader is busy are simply replaced by
+    newer ones.
+
+    numReadBuffers lets the reader keep using the values it acquired before
+    the newest one. With 2, the previous value stays untouched until the
+    next acquire, at the cost of a fourth buffer, so a reader can hold on
+    to the old value while it moves over to the new one without copying
+    either.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+template <typename Type, int numReadBuffers = 1>
+class TripleBuffer
+{
+public:
+    static_assert(numReadBuffers == 1 || numReadBuffers == 2, "the indices only have room for four buffers");
+
+    TripleBuffer() noexcept
+    {
+        for (int i = 0; i < numReadBuffers; ++i)
+            readIndices[(size_t) i] = 2 + i;
+    }
+
+    //writer side: the buffer to fill before calling publish()
+    Type& getWriteBuffer() noexcept { return buffers[(size_t) backIndex]; }
+
+    //writer side: hands the write buffer over and takes back whichever one the reader isn't using
+    void publish() noexcept
+    {
+        backIndex = middle.exchange(backIndex | newDataFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    //reader side: returns the newest published value, or nullptr if nothing was published since the last call
+    //the oldest value the reader holds is given back to the writer, the others stay valid
+    const Type* acquire() noexcept
+    {
+        if ((middle.load(std::memory_order_acquire) & newDataFlag) == 0)
+            return nullptr;
+
+        auto oldestIndex = readIndices.back();
+
+        for (size_t i = readIndices.size() - 1; i > 0; --i)
+            readIndices[i] = readIndices[i - 1];
+
+        readIndices.front() = middle.exchange(oldestIndex, std::memory_order_acq_rel) & indexMask;
+        return &buffers[(size_t) readIndices.front()];
+    }
+
+    //reader side: the value returned by the last successful acquire()
+    const Type& getReadBuffer() const noexcept { return buffers[(size_t) readIndices.front()]; }
+
+    //only while neither side is running: lets all three buffers be sized up front so publishing never allocates
+    template <typename Function>
+    void forEachBuffer(Function&& function)
+    {
+        for (auto& buffer : buffers)
+            function(buffer);
+    }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int newDataFlag = 4;
+
+    std::array<Type, 2 + numReadBuffers> buffers{};
+
+    int backIndex{ 0 };                                     //only touched by the writer
+    std::array<int, (size_t) numReadBuffers> readIndices;   //only touched by the reader, newest first
+    std::atomic<int> middle{ 1 };                           //index of the buffer in between, plus newDataFlag
+
+    JUCE_DECLARE_NON_COPYABLE (TripleBuffer)
+};
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    AllocationTests.cpp
+
+    processBlock never allocates, frees or locks, whatever the parameters do
+    between blocks. The violations are counted by RealtimeSafety on the
+    thread that calls processBlock, so whatever the designer's worker does
+    meanwhile doesn't count.
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+class AllocationTests : public juce::UnitTest
+{
+public:
+    AllocationTests() : juce::UnitTest("Allocations in processBlock", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        beginTest("Band parameters changing every block");
+        {
+            auto processor = TestHelpers::createProcessor();
+            auto random = getRandom();
+
+            const juce::StringArray parameterIDs{ "LowCut Freq", "LowCut Slope", "HighCut Freq", "HighCut Slope",
+                                                  "Peak Freq", "Peak Gain", "Peak Quality",
+                                                  "Band 1 Type", "Band 1 Freq", "Band 1 Gain" };
+
+            auto violations = processBlocks(*processor, 400, [&](int block)
+            {
+                for (const auto& parameterID : parameterIDs)
+                    if (random.nextBool())
+                        processor->apvts.getParameter(parameterID)->setValueNotifyingHost(random.nextFloat());
+
+                //some blocks pick up a set the designer published, the rest only see the dirty flags
+                if (block % 8 == 0)
+                    juce::Thread::sleep(2);
+            });
+
+            expectNoViolations(violations);
+        }
+
+        beginTest("Switching processing modes between blocks");
+        {
+            auto processor = TestHelpers::createProcessor();
+            TestHelpers::setAllBandsActive(*processor);
+
+            auto violations = processBlocks(*processor, 160, [&](int block)
+            {
+                //a new mode every 8 blocks, given time to be designed so the audio thread switches to it
+                if (block % 8 != 0)
+                    return;
+
+                auto step = block / 8;
+
+                TestHelpers::setParameter(*processor, "Oversampling", (float) (step % 4));
+                TestHelpers::setParameter(*processor, "Linear Phase", step % 5 == 4 ? 1.f : 0.f);
+                TestHelpers::setParameter(*processor, "Dynamic", step % 3 == 1 ? 1.f : 0.f);
+
+                processor->setSmoothingSubBlockSize(step % 2 == 0 ? 0 : 32);
+                processor->setUseSimdProcessing(step % 4 >= 2);
+                processor->setFilterEngine(step % 6 == 5 ? SimpleEQAudioProcessor::FilterEngine::stateVariable
+                                                         : SimpleEQAudioProcessor::FilterEngine::biquad);
+                processor->setPrecisionMode(step % 3 == 2 ? SimpleEQAudioProcessor::PrecisionMode::doublePrecision
+                                                          : SimpleEQAudioProcessor::PrecisionMode::automatic);
+
+                TestHelpers::waitForDesigner();
+            });
+
+            expectNoViolations(violations);
+        }
+    }
+
+private:
+    //processes numBlocks of noise, calling changeParameters before each, and adds up what processBlock did
+    template <typename Function>
+    static TestHelpers::Violations processBlocks(SimpleEQAudioProcessor& processor, int numBlocks, Function&& changeParameters)
+    {
+        juce::AudioBuffer<float> buffer(2, 512);
+        juce::Random random(1234);
+        TestHelpers::Violations violations;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            changeParameters(block);
+            TestHelpers::fillWithNoise(buffer, random);
+
+            violations += TestHelpers::processCountingViolations(processor, buffer);
+        }
+
+        return violations;
+    }
+
+    void expectNoViolations(const TestHelpers::Violations& violations)
+    {
+        expectEquals(violations.allocations, (juce::int64) 0, "allocations inside processBlock");
+        expectEquals(violations.deallocations, (juce::int64) 0, "deallocations inside processBlock");
+        expectEquals(violations.mutexLocks, (juce::int64) 0, "mutex locks inside processBlock");
+    }
+};
+
+static AllocationTests allocationTests;
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    CoefficientDesignerTests.cpp
+
+    A host thread automating the band parameters as fast as it can while the
+    test thread plays the audio thread. Every set the designer publishes has
+    to be designed from the settings it carries, and processBlock must not
+    wait on the designer or allocate while it picks the sets up.
+
+    The threads only share the parameters' atomics and the TripleBuffer, so
+    this runs clean under ThreadSanitizer.
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+class CoefficientDesignerTests : public juce::UnitTest
+{
+public:
+    CoefficientDesignerTests() : juce::UnitTest("Coefficient designer", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        beginTest("Published sets stay consistent under automation from another thread");
+
+        constexpr double sampleRate = 48000;
+        constexpr double seconds = 1.0;
+
+        auto processor = TestHelpers::createProcessor(juce::AudioChannelSet::stereo(), sampleRate, 256);
+
+        //a second designer on the same parameters, so the test can look at every set it publishes
+        ParameterCache parameters(processor->apvts);
+        CoefficientDesigner designer(parameters);
+        designer.prepare(sampleRate);
+
+        AutomationThread automation(*processor, getRandom().nextInt(1 << 30));
+        automation.startThread();
+
+        juce::AudioBuffer<float> buffer(2, 256);
+        juce::Random random(1234);
+        TestHelpers::Violations violations;
+        int numSetsChecked = 0, numInconsistentSets = 0;
+
+        auto endTime = juce::Time::getMillisecondCounterHiRes() + seconds * 1000.0;
+
+        while (juce::Time::getMillisecondCounterHiRes() < endTime)
+        {
+            TestHelpers::fillWithNoise(buffer, random);
+            violations += TestHelpers::processCountingViolations(*processor, buffer);
+
+            if (auto* sets = designer.acquireCoefficients())
+            {
+                for (const auto& set : *sets)
+                    if (! isDesignedFromItsSettings(set, sampleRate))
+                        ++numInconsistentSets;
+
+                ++numSetsChecked;
+            }
+
+            juce::Thread::yield();
+        }
+
+        automation.stopThread(1000);
+        designer.release();
+
+        //the designer polls every millisecond while the parameters move, a second gives it hundreds of chances
+        expectGreaterThan(automation.numChanges.load(), 100);
+        expectGreaterThan(numSetsChecked, 10);
+        expectEquals(numInconsistentSets, 0, "sets whose coefficients don't match their settings");
+
+        expectEquals(violations.allocations, (juce::int64) 0, "allocations inside processBlock");
+        expectEquals(violations.deallocations, (juce::int64) 0, "deallocations inside processBlock");
+        expectEquals(violations.mutexLocks, (juce::int64) 0, "mutex locks inside processBlock");
+    }
+
+private:
+    //sets random band parameters back to back, like a host sending automation from its own thread
+    struct AutomationThread : public juce::Thread
+    {
+        AutomationThread(SimpleEQAudioProcessor& processorToAutomate, int seed)
+            : juce::Thread("SimpleEQ Test Automation"), processor(processorToAutomate), random(seed)
+        {
+        }
+
+        void run() override
+        {
+            const juce::StringArray parameterIDs{ "LowCut Freq", "LowCut Slope", "HighCut Freq", "HighCut Slope",
+                                                  "Peak Freq", "Peak Gain", "Peak Quality" };
+
+            while (! threadShouldExit())
+            {
+                auto parameterID = parameterIDs[random.nextInt(parameterIDs.size())];
+                processor.apvts.getParameter(parameterID)->setValueNotifyingHost(random.nextFloat());
+
+                ++numChanges;
+            }
+        }
+
+        SimpleEQAudioProcessor& processor;
+        juce::Random random;
+        std::atomic<int> numChanges{ 0 };
+    };
+
+    //the designs are deterministic and the cache is keyed on the exact settings, so a consistent set matches exactly
+    static bool isDesignedFromItsSettings(const FilterCoefficientSet& set, double sampleRate)
+    {
+        const auto& settings = set.settings;
+
+        if (set.lowCutSlope != settings.lowCutSlope || set.highCutSlope != settings.highCutSlope)
+            return false;
+
+        if (set.peak != makePeakCoefficients(settings, sampleRate))
+            return false;
+
+        auto lowCut = makeLowCutCoefficients(settings, sampleRate);
+        auto highCut = makeHighCutCoefficients(settings, sampleRate);
+
+        for (int i = 0; i < getNumCutSections(settings.lowCutSlope); ++i)
+            if (set.lowCut[(size_t) i] != lowCut[(size_t) i])
+                return false;
+
+        for (int i = 0; i < getNumCutSections(settings.highCutSlope); ++i)
+            if (set.highCut[(size_t) i] != highCut[(size_t) i])
+                return false;
+
+        return true;
+    }
+};
+
+static CoefficientDesignerTests coefficientDesignerTests;
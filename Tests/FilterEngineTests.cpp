@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    FilterEngineTests.cpp
+
+    The state variable filters are the same bilinear transform of the same
+    sections as the biquads, so with the parameters standing still the two
+    engines have the same transfer function and the same noise has to come
+    out of both the same, to within rounding. A wrong section Q in the cuts
+    or a wrong k or m1 in the peak moves the response by far more than that.
+    Double buffers keep the rounding well under the tolerance.
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+class FilterEngineTests : public juce::UnitTest
+{
+public:
+    FilterEngineTests() : juce::UnitTest("Filter engines", "SimpleEQ") {}
+
+    //difference energy allowed between the engines, relative to the biquads' output
+    static constexpr double maxDifferenceDecibels = -80.0;
+
+    void runTest() override
+    {
+        using FilterEngine = SimpleEQAudioProcessor::FilterEngine;
+
+        for (auto peakGain : { 12.f, -12.f })
+        {
+            beginTest(peakGain > 0 ? "State variable filters match the biquads with a boosted peak"
+                                   : "State variable filters match the biquads with a cut peak");
+
+            for (auto lowCutSlope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+                for (auto highCutSlope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+                {
+                    auto biquadOutput = render(FilterEngine::biquad, lowCutSlope, highCutSlope, peakGain);
+                    auto svfOutput = render(FilterEngine::stateVariable, lowCutSlope, highCutSlope, peakGain);
+
+                    auto difference = TestHelpers::getErrorDecibels(svfOutput, biquadOutput);
+
+                    expect(difference <= maxDifferenceDecibels,
+                           "slopes " + juce::String(12 * (lowCutSlope + 1)) + "/" + juce::String(12 * (highCutSlope + 1))
+                           + ", peak " + juce::String(peakGain) + " dB, difference " + juce::String(difference) + " dB");
+                }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000;
+    static constexpr int blockSize = 512;
+
+    //half a second of noise through every band, with the cuts and the peak well inside the audible range
+    static std::vector<double> render(SimpleEQAudioProcessor::FilterEngine engine, Slope lowCutSlope, Slope highCutSlope, float peakGain)
+    {
+        auto processor = TestHelpers::createProcessor(juce::AudioChannelSet::mono(), sampleRate, blockSize);
+
+        TestHelpers::setParameter(*processor, "LowCut Freq", 100.f);
+        TestHelpers::setParameter(*processor, "LowCut Slope", (float) lowCutSlope);
+        TestHelpers::setParameter(*processor, "HighCut Freq", 5000.f);
+        TestHelpers::setParameter(*processor, "HighCut Slope", (float) highCutSlope);
+        TestHelpers::setParameter(*processor, "Peak Freq", 1000.f);
+        TestHelpers::setParameter(*processor, "Peak Gain", peakGain);
+        TestHelpers::setParameter(*processor, "Peak Quality", 2.f);
+
+        //no ramps, so both engines sit on the designed response from the first sample
+        processor->setSmoothingSubBlockSize(0);
+        processor->setFilterEngine(engine);
+        processor->setProcessingPrecision(juce::AudioProcessor::doublePrecision);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        auto output = TestHelpers::render<double>(*processor, TestHelpers::makeNoise((int) sampleRate / 2, 1234), blockSize);
+
+        processor->releaseResources();
+        return output;
+    }
+};
+
+static FilterEngineTests filterEngineTests;
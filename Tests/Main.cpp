@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    Unit tests: runs every juce::UnitTest in the "SimpleEQ" category and
+    exits with 1 if any expectation failed, so CTest can run it as it is.
+
+    SimpleEQTests [--seed 1234]
+
+    The tests drive SimpleEQAudioProcessor directly, without a host, and
+    count the allocations and locks made inside processBlock through
+    RealtimeSafety, so this target is always built with
+    SIMPLEEQ_RT_SAFETY_CHECKS=1, like the benchmark.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "../Source/RealtimeSafety.h"
+
+//==============================================================================
+#if ! SIMPLEEQ_RT_SAFETY_CHECKS
+ #error "The tests count allocations through RealtimeSafety, build them with SIMPLEEQ_RT_SAFETY_CHECKS=1"
+#endif
+
+int main (int argc, char* argv[])
+{
+    //the processor's timer and the editor components need a message thread, this one is it
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    //the tests read the violation counts, logging each one would only bury the results
+    RealtimeSafety::setLoggingEnabled(false);
+
+    auto seed = args.containsOption("--seed") ? args.getValueForOption("--seed").getLargeIntValue() : (juce::int64) 0;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory("SimpleEQ", seed);
+
+    int numPasses = 0, numFailures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+    {
+        if (auto* result = runner.getResult(i))
+        {
+            numPasses += result->passes;
+            numFailures += result->failures;
+        }
+    }
+
+    std::cout << numPasses << " passed, " << numFailures << " failed" << std::endl;
+
+    return numFailures > 0 ? 1 : 0;
+}
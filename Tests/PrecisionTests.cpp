@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    PrecisionTests.cpp
+
+    A Slope_48 low cut at 20 Hz and 192 kHz has its poles so close to z = 1
+    that float filter state drifts well away from the exact response. The
+    automatic and double precision modes have to keep it in double and stay
+    within maxErrorDecibels of a long double run of the same designs. The
+    benchmark's precisionAccuracy suite reports the same error for more
+    cases.
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+class PrecisionTests : public juce::UnitTest
+{
+public:
+    PrecisionTests() : juce::UnitTest("Precision modes", "SimpleEQ") {}
+
+    //error energy allowed against the reference, relative to the output
+    static constexpr double maxErrorDecibels = -90.0;
+
+    void runTest() override
+    {
+        using PrecisionMode = SimpleEQAudioProcessor::PrecisionMode;
+
+        auto singleError = renderError(PrecisionMode::singlePrecision, nullptr);
+
+        beginTest("Automatic mode runs a 20 Hz low cut at 192 kHz in double");
+        {
+            int doubleBands = 0;
+            auto error = renderError(PrecisionMode::automatic, &doubleBands);
+
+            expect((doubleBands & ParameterCache::lowCutBand) != 0, "the low cut should run in double");
+            expect(error <= maxErrorDecibels, "error " + juce::String(error) + " dB");
+
+            //otherwise the case is one float handles anyway and proves nothing
+            expectGreaterThan(singleError, error);
+        }
+
+        beginTest("Double precision mode runs a 20 Hz low cut at 192 kHz in double");
+        {
+            int doubleBands = 0;
+            auto error = renderError(PrecisionMode::doublePrecision, &doubleBands);
+
+            expectEquals(doubleBands & (ParameterCache::lowCutBand | ParameterCache::highCutBand),
+                         ParameterCache::lowCutBand | ParameterCache::highCutBand);
+            expect(error <= maxErrorDecibels, "error " + juce::String(error) + " dB");
+        }
+
+        logMessage("single precision error " + juce::String(singleError) + " dB");
+    }
+
+private:
+    static constexpr double sampleRate = 192000;
+    static constexpr int blockSize = 512;
+
+    //the designs the processor uses, run in long double transposed direct form II
+    class ReferenceCascade
+    {
+    public:
+        ReferenceCascade(const ChainSettings& settings, double rate)
+        {
+            auto lowCut = makeLowCutCoefficients(settings, rate);
+            auto highCut = makeHighCutCoefficients(settings, rate);
+
+            for (int i = 0; i < getNumCutSections(settings.lowCutSlope); ++i)
+                stages.push_back({ lowCut[(size_t) i] });
+
+            stages.push_back({ makePeakCoefficients(settings, rate) });
+
+            for (int i = 0; i < getNumCutSections(settings.highCutSlope); ++i)
+                stages.push_back({ highCut[(size_t) i] });
+        }
+
+        long double process(long double x) noexcept
+        {
+            for (auto& stage : stages)
+            {
+                const auto& c = stage.coefficients;
+
+                auto y = c[0] * x + stage.s1;
+                stage.s1 = c[1] * x - c[3] * y + stage.s2;
+                stage.s2 = c[2] * x - c[4] * y;
+                x = y;
+            }
+
+            return x;
+        }
+
+    private:
+        struct Stage
+        {
+            BiquadCoefficients coefficients;
+            long double s1{ 0 }, s2{ 0 };
+        };
+
+        std::vector<Stage> stages;
+    };
+
+    //a second of noise through float buffers, returns the error in dB and which bands the channel ran in double
+    static double renderError(SimpleEQAudioProcessor::PrecisionMode precisionMode, int* doubleBands)
+    {
+        auto processor = TestHelpers::createProcessor(juce::AudioChannelSet::mono(), sampleRate, blockSize);
+
+        TestHelpers::setParameter(*processor, "LowCut Freq", 20.f);
+        TestHelpers::setParameter(*processor, "LowCut Slope", (float) Slope_48);
+
+        processor->setSmoothingSubBlockSize(0);
+        processor->setPrecisionMode(precisionMode);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        auto input = TestHelpers::makeNoise((int) sampleRate, 1234);
+        auto output = TestHelpers::render<float>(*processor, input, blockSize);
+
+        if (doubleBands != nullptr)
+            *doubleBands = processor->getChannelDoublePrecisionBands(0);
+
+        processor->releaseResources();
+
+        ReferenceCascade reference(getChainSettings(processor->apvts), sampleRate);
+        std::vector<double> expected;
+        expected.reserve(input.size());
+
+        for (auto sample : input)
+            expected.push_back((double) reference.process(sample));
+
+        return TestHelpers::getErrorDecibels(output, expected);
+    }
+};
+
+static PrecisionTests precisionTests;
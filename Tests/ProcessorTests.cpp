@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    ProcessorTests.cpp
+
+    Every bus layout the processor accepts prepares and produces sane output.
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+class ProcessorTests : public juce::UnitTest
+{
+public:
+    ProcessorTests() : juce::UnitTest("Processor", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        for (auto layout : { juce::AudioChannelSet::mono(),
+                             juce::AudioChannelSet::stereo(),
+                             juce::AudioChannelSet::create5point1(),
+                             juce::AudioChannelSet::create7point1point4() })
+        {
+            beginTest("Processes " + layout.getDescription());
+
+            auto processor = TestHelpers::createProcessor(layout);
+            TestHelpers::setAllBandsActive(*processor);
+            TestHelpers::waitForDesigner();
+
+            expect(processor->isBusesLayoutSupported(processor->getBusesLayout()));
+            expectEquals(processor->getLatencySamples(), 0);
+
+            juce::AudioBuffer<float> buffer(layout.size(), 512);
+            juce::MidiBuffer midi;
+            juce::Random random(1234);
+
+            for (int block = 0; block < 32; ++block)
+            {
+                TestHelpers::fillWithNoise(buffer, random);
+                processor->processBlock(buffer, midi);
+
+                //noise with a 6 dB peak on it stays well inside this, anything unstable doesn't
+                auto peak = TestHelpers::getPeakLevel(buffer);
+                expect(peak < 8.0, "output peak " + juce::String(peak));
+            }
+
+            //the cut bands ring for a while after the input stops
+            expectGreaterThan(processor->getTailLengthSeconds(), 0.0);
+
+            processor->releaseResources();
+        }
+    }
+};
+
+static ProcessorTests processorTests;
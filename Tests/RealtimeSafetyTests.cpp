@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyTests.cpp
+
+    The replaced allocation functions count what the audio thread does and
+    nothing else, and the aligned ones hand back memory that is aligned
+    and that their own delete can free.
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "../Source/RealtimeSafety.h"
+
+class RealtimeSafetyTests : public juce::UnitTest
+{
+public:
+    RealtimeSafetyTests() : juce::UnitTest("Realtime safety checks", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        using RealtimeSafety::ViolationType;
+
+        //the operators are called directly, a new expression whose result isn't used can be optimised away
+        beginTest("Only the audio thread's allocations count");
+        {
+            auto before = RealtimeSafety::getThreadViolationCount();
+
+            ::operator delete(::operator new(64));
+
+            expectEquals(RealtimeSafety::getThreadViolationCount(), before);
+
+            {
+                RealtimeSafety::ScopedAudioThread audioThread;
+                expect(RealtimeSafety::isAudioThread());
+
+                auto allocations = RealtimeSafety::getThreadViolationCount(ViolationType::allocation);
+                auto deallocations = RealtimeSafety::getThreadViolationCount(ViolationType::deallocation);
+
+                ::operator delete(::operator new(64));
+
+                expectEquals(RealtimeSafety::getThreadViolationCount(ViolationType::allocation), allocations + 1);
+                expectEquals(RealtimeSafety::getThreadViolationCount(ViolationType::deallocation), deallocations + 1);
+            }
+
+            expect(! RealtimeSafety::isAudioThread());
+        }
+
+        beginTest("Aligned allocations are aligned and counted");
+        {
+            RealtimeSafety::ScopedAudioThread audioThread;
+
+            auto allocations = RealtimeSafety::getThreadViolationCount(ViolationType::allocation);
+            auto deallocations = RealtimeSafety::getThreadViolationCount(ViolationType::deallocation);
+
+            //sizes that aren't a multiple of the alignment, and 0, which still has to give a unique pointer
+            for (auto alignment : { (size_t) 16, (size_t) 64, (size_t) 4096 })
+            {
+                for (auto size : { (size_t) 0, (size_t) 1, (size_t) 100 })
+                {
+                    auto* ptr = ::operator new(size, std::align_val_t(alignment));
+                    expectEquals((int) (reinterpret_cast<juce::pointer_sized_uint>(ptr) % alignment), 0);
+                    ::operator delete(ptr, std::align_val_t(alignment));
+
+                    auto* nothrowPtr = ::operator new[](size, std::align_val_t(alignment), std::nothrow);
+                    expect(nothrowPtr != nullptr);
+                    ::operator delete[](nothrowPtr, std::align_val_t(alignment), std::nothrow);
+                }
+            }
+
+            expectEquals(RealtimeSafety::getThreadViolationCount(ViolationType::allocation), allocations + 18);
+            expectEquals(RealtimeSafety::getThreadViolationCount(ViolationType::deallocation), deallocations + 18);
+        }
+    }
+};
+
+static RealtimeSafetyTests realtimeSafetyTests;
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    SimdPathTests.cpp
+
+    The SIMD cascades and the per-channel MonoChains are two ways of running
+    the same float biquads, so the same input through either has to come out
+    the same to within rounding, for every stage either of them can leave
+    out. The benchmark's pathEquivalence suite runs the same comparison over
+    more channel counts.
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+class SimdPathTests : public juce::UnitTest
+{
+public:
+    SimdPathTests() : juce::UnitTest("SIMD path", "SimpleEQ") {}
+
+    //largest sample difference allowed between the paths, -80 dB below full scale
+    static constexpr double tolerance = 1.0e-4;
+
+    void runTest() override
+    {
+        using PrecisionMode = SimpleEQAudioProcessor::PrecisionMode;
+
+        for (auto precisionMode : { PrecisionMode::singlePrecision, PrecisionMode::doublePrecision })
+        {
+            beginTest(precisionMode == PrecisionMode::singlePrecision ? "Matches the MonoChains with the cut bands in float"
+                                                                      : "Matches the MonoChains with the cut bands in double");
+
+            for (auto lowCutSlope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+                for (auto highCutSlope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+                    for (auto peakGain : { 0.f, 6.f })
+                    {
+                        auto monoChainOutput = render(false, precisionMode, lowCutSlope, highCutSlope, peakGain);
+                        auto simdOutput = render(true, precisionMode, lowCutSlope, highCutSlope, peakGain);
+
+                        auto maxDifference = 0.0;
+
+                        //a NaN in either output counts as an infinite difference, jmax would skip over it
+                        for (size_t i = 0; i < monoChainOutput.size(); ++i)
+                        {
+                            auto difference = std::abs((double) monoChainOutput[i] - (double) simdOutput[i]);
+                            maxDifference = std::isnan(difference) ? std::numeric_limits<double>::infinity()
+                                                                   : juce::jmax(maxDifference, difference);
+                        }
+
+                        expect(maxDifference <= tolerance,
+                               "slopes " + juce::String(12 * (lowCutSlope + 1)) + "/" + juce::String(12 * (highCutSlope + 1))
+                               + ", peak " + juce::String(peakGain) + " dB, max difference " + juce::String(maxDifference));
+                    }
+        }
+    }
+
+private:
+    //the same half second of noise through three channels, so the SIMD cascade has lanes left empty
+    static std::vector<float> render(bool useSimd, SimpleEQAudioProcessor::PrecisionMode precisionMode,
+                                     Slope lowCutSlope, Slope highCutSlope, float peakGain)
+    {
+        constexpr double sampleRate = 48000;
+        constexpr int blockSize = 512;
+        constexpr int numBlocks = 47;
+
+        auto layout = juce::AudioChannelSet::canonicalChannelSet(3);
+        auto processor = TestHelpers::createProcessor(layout, sampleRate, blockSize);
+
+        TestHelpers::setAllBandsActive(*processor);
+        TestHelpers::setParameter(*processor, "LowCut Slope", (float) lowCutSlope);
+        TestHelpers::setParameter(*processor, "HighCut Slope", (float) highCutSlope);
+        TestHelpers::setParameter(*processor, "Peak Gain", peakGain);
+
+        processor->setUseSimdProcessing(useSimd);
+        processor->setPrecisionMode(precisionMode);
+        processor->setSmoothingSubBlockSize(0);
+
+        //prepare designs every band before it returns, so both paths start from the same coefficients
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(layout.size(), blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1234);
+        std::vector<float> output;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            TestHelpers::fillWithNoise(buffer, random);
+            processor->processBlock(buffer, midi);
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    output.push_back(buffer.getSample(ch, i));
+        }
+
+        processor->releaseResources();
+        return output;
+    }
+};
+
+static SimdPathTests simdPathTests;
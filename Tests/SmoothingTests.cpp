@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    SmoothingTests.cpp
+
+    Peak Gain and Peak Freq jumping around under a steady sine. With
+    smoothing off the new coefficients land all at once and the filter's
+    output steps, which shows up as energy in its second difference. With
+    smoothing on the same jumps are ramped over sub-blocks, so there has to
+    be far less of it.
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+class SmoothingTests : public juce::UnitTest
+{
+public:
+    SmoothingTests() : juce::UnitTest("Parameter smoothing", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        beginTest("Automated peak gain and frequency step less with smoothing on");
+
+        auto stepEnergyWithoutSmoothing = renderStepEnergy(0);
+        auto stepEnergyWithSmoothing = renderStepEnergy(32);
+
+        logMessage("step energy " + juce::String(stepEnergyWithoutSmoothing) + " without smoothing, "
+                   + juce::String(stepEnergyWithSmoothing) + " with");
+
+        expectGreaterThan(stepEnergyWithoutSmoothing, 0.0);
+        expectLessThan(stepEnergyWithSmoothing, stepEnergyWithoutSmoothing * 0.5);
+
+        beginTest("The smoothed output settles on the unsmoothed one");
+        {
+            //once the ramps are over the linked groups run the designer's set again, the same one as without smoothing
+            auto processorWithout = createSineProcessor(0);
+            auto processorWith = createSineProcessor(32);
+
+            std::vector<float> outputWithout, outputWith;
+
+            //the first blocks switch smoothing on, the jump after them is the one that gets ramped
+            render(*processorWithout, outputWithout, 4);
+            render(*processorWith, outputWith, 4);
+
+            for (auto* processor : { processorWithout.get(), processorWith.get() })
+                TestHelpers::setParameter(*processor, "Peak Gain", 12.f);
+
+            TestHelpers::waitForDesigner();
+
+            render(*processorWithout, outputWithout, 64);
+            render(*processorWith, outputWith, 64);
+
+            //the ramps take 20 ms, the last half of the render is well past them
+            auto maxDifference = 0.0;
+
+            for (size_t i = outputWith.size() / 2; i < outputWith.size(); ++i)
+            {
+                auto difference = std::abs((double) outputWith[i] - (double) outputWithout[i]);
+                maxDifference = std::isnan(difference) ? std::numeric_limits<double>::infinity()
+                                                       : juce::jmax(maxDifference, difference);
+            }
+
+            expectLessThan(maxDifference, 1.0e-4);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000;
+    static constexpr int blockSize = 256;
+    static constexpr double sineFrequency = 200;
+
+    //a flat processor on a 200 Hz peak, so the automation moves the band the sine is sitting in
+    static std::unique_ptr<SimpleEQAudioProcessor> createSineProcessor(int subBlockSize)
+    {
+        auto processor = TestHelpers::createProcessor(juce::AudioChannelSet::stereo(), sampleRate, blockSize);
+
+        TestHelpers::setParameter(*processor, "LowCut Freq", 20.f);
+        TestHelpers::setParameter(*processor, "HighCut Freq", 20000.f);
+        TestHelpers::setParameter(*processor, "Peak Freq", (float) sineFrequency);
+        TestHelpers::setParameter(*processor, "Peak Gain", 0.f);
+        TestHelpers::setParameter(*processor, "Peak Quality", 1.f);
+
+        processor->setSmoothingSubBlockSize(subBlockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        return processor;
+    }
+
+    //processes numBlocks of the sine, carrying on its phase from the last call, and keeps the left channel
+    static void render(SimpleEQAudioProcessor& processor, std::vector<float>& output, int numBlocks)
+    {
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                auto phase = juce::MathConstants<double>::twoPi * sineFrequency * (double) (output.size() + (size_t) i) / sampleRate;
+                auto sample = (float) (0.5 * std::sin(phase));
+
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample);
+            }
+
+            processor.processBlock(buffer, midi);
+            output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockSize);
+        }
+    }
+
+    //sums the squared second difference of the output while the peak jumps every 4 blocks, after a warm-up block
+    static double renderStepEnergy(int subBlockSize)
+    {
+        constexpr int numJumps = 12;
+        constexpr int blocksPerJump = 4;
+
+        auto processor = createSineProcessor(subBlockSize);
+        std::vector<float> output;
+
+        render(*processor, output, blocksPerJump);
+
+        for (int jump = 0; jump < numJumps; ++jump)
+        {
+            TestHelpers::setParameter(*processor, "Peak Gain", jump % 2 == 0 ? 12.f : -12.f);
+            TestHelpers::setParameter(*processor, "Peak Freq", jump % 2 == 0 ? 400.f : (float) sineFrequency);
+
+            //both runs pick the jump up at the same block, from the designer's set or the smoother's target
+            TestHelpers::waitForDesigner();
+
+            render(*processor, output, blocksPerJump);
+        }
+
+        auto energy = 0.0;
+
+        for (size_t i = (size_t) blockSize + 2; i < output.size(); ++i)
+        {
+            auto secondDifference = (double) output[i] - 2.0 * (double) output[i - 1] + (double) output[i - 2];
+            energy += secondDifference * secondDifference;
+        }
+
+        return energy;
+    }
+};
+
+static SmoothingTests smoothingTests;
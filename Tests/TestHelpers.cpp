@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    TestHelpers.cpp
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+namespace TestHelpers
+{
+    void setParameter(SimpleEQAudioProcessor& processor, const juce::String& parameterID, float value)
+    {
+        auto* parameter = processor.apvts.getParameter(parameterID);
+        jassert(parameter != nullptr);
+
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    std::unique_ptr<SimpleEQAudioProcessor> createProcessor(const juce::AudioChannelSet& layout, double sampleRate, int blockSize)
+    {
+        auto processor = std::make_unique<SimpleEQAudioProcessor>();
+
+        juce::AudioProcessor::BusesLayout busesLayout;
+        busesLayout.inputBuses.add(layout);
+        busesLayout.inputBuses.add(juce::AudioChannelSet::disabled());
+        busesLayout.outputBuses.add(layout);
+        processor->setBusesLayout(busesLayout);
+
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        return processor;
+    }
+
+    void setAllBandsActive(SimpleEQAudioProcessor& processor)
+    {
+        setParameter(processor, "LowCut Freq", 80.f);
+        setParameter(processor, "HighCut Freq", 12000.f);
+        setParameter(processor, "Peak Freq", 1000.f);
+        setParameter(processor, "Peak Gain", 6.f);
+        setParameter(processor, "Peak Quality", 1.f);
+        setParameter(processor, "LowCut Slope", (float) Slope_48);
+        setParameter(processor, "HighCut Slope", (float) Slope_48);
+    }
+
+    std::vector<float> makeNoise(int numSamples, int seed)
+    {
+        juce::Random random(seed);
+        std::vector<float> noise((size_t) numSamples);
+
+        for (auto& sample : noise)
+            sample = random.nextFloat() * 2.f - 1.f;
+
+        return noise;
+    }
+
+    double getErrorDecibels(const std::vector<double>& output, const std::vector<double>& reference)
+    {
+        jassert(output.size() == reference.size());
+
+        long double errorEnergy = 0, referenceEnergy = 0;
+
+        for (size_t i = 0; i < output.size(); ++i)
+        {
+            auto error = (long double) output[i] - (long double) reference[i];
+
+            errorEnergy += error * error;
+            referenceEnergy += (long double) reference[i] * (long double) reference[i];
+        }
+
+        if (! std::isfinite((double) errorEnergy))
+            return std::numeric_limits<double>::infinity();
+
+        return juce::Decibels::gainToDecibels((double) std::sqrt(errorEnergy / referenceEnergy), -300.0);
+    }
+
+    double getPeakLevel(const juce::AudioBuffer<float>& buffer)
+    {
+        auto peak = 0.0;
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                auto sample = (double) buffer.getSample(ch, i);
+
+                if (! std::isfinite(sample))
+                    return std::numeric_limits<double>::infinity();
+
+                peak = juce::jmax(peak, std::abs(sample));
+            }
+
+        return peak;
+    }
+
+    Violations& Violations::operator+= (const Violations& other) noexcept
+    {
+        allocations += other.allocations;
+        deallocations += other.deallocations;
+        mutexLocks += other.mutexLocks;
+        return *this;
+    }
+
+    Violations processCountingViolations(SimpleEQAudioProcessor& processor, juce::AudioBuffer<float>& buffer)
+    {
+        using RealtimeSafety::ViolationType;
+
+        juce::MidiBuffer midi;
+        Violations before, made;
+
+        before.allocations = RealtimeSafety::getThreadViolationCount(ViolationType::allocation);
+        before.deallocations = RealtimeSafety::getThreadViolationCount(ViolationType::deallocation);
+        before.mutexLocks = RealtimeSafety::getThreadViolationCount(ViolationType::mutexLock);
+
+        processor.processBlock(buffer, midi);
+
+        made.allocations = RealtimeSafety::getThreadViolationCount(ViolationType::allocation) - before.allocations;
+        made.deallocations = RealtimeSafety::getThreadViolationCount(ViolationType::deallocation) - before.deallocations;
+        made.mutexLocks = RealtimeSafety::getThreadViolationCount(ViolationType::mutexLock) - before.mutexLocks;
+
+        return made;
+    }
+
+    void waitForDesigner()
+    {
+        juce::Thread::sleep(20);
+    }
+}
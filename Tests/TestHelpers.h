@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    TestHelpers.h
+
+    What the unit tests share: building a prepared processor without a host,
+    setting parameters the way a host does, and feeding it noise.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Source/PluginProcessor.h"
+
+namespace TestHelpers
+{
+    //sets a parameter in its own units, choice parameters take the choice index
+    void setParameter(SimpleEQAudioProcessor& processor, const juce::String& parameterID, float value);
+
+    //a processor with the same layout on its main input and output and no sidechain, prepared to play
+    std::unique_ptr<SimpleEQAudioProcessor> createProcessor(const juce::AudioChannelSet& layout = juce::AudioChannelSet::stereo(),
+                                                            double sampleRate = 48000,
+                                                            int blockSize = 512);
+
+    //the settings the benchmark uses, every stage of the chain doing something
+    void setAllBandsActive(SimpleEQAudioProcessor& processor);
+
+    //white noise between -1 and 1, the same samples for the same Random seed
+    template <typename SampleType>
+    void fillWithNoise(juce::AudioBuffer<SampleType>& buffer, juce::Random& random)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(ch, i, (SampleType) (random.nextFloat() * 2.f - 1.f));
+    }
+
+    //white noise in float, so every render of it starts from exactly the same samples whatever the buffer type
+    std::vector<float> makeNoise(int numSamples, int seed);
+
+    //runs a mono signal through a mono processor in blocks and returns the output, in float or double buffers
+    template <typename SampleType>
+    std::vector<double> render(SimpleEQAudioProcessor& processor, const std::vector<float>& input, int blockSize)
+    {
+        juce::AudioBuffer<SampleType> buffer(1, blockSize);
+        juce::MidiBuffer midi;
+        std::vector<double> output;
+        output.reserve(input.size());
+
+        for (size_t start = 0; start < input.size(); start += (size_t) blockSize)
+        {
+            auto numSamples = (int) juce::jmin((size_t) blockSize, input.size() - start);
+            buffer.setSize(1, numSamples, false, false, true);
+
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(0, i, (SampleType) input[start + (size_t) i]);
+
+            processor.processBlock(buffer, midi);
+
+            for (int i = 0; i < numSamples; ++i)
+                output.push_back((double) buffer.getSample(0, i));
+        }
+
+        return output;
+    }
+
+    //energy of the difference over the energy of the reference, in dB, +infinity if the output isn't finite
+    double getErrorDecibels(const std::vector<double>& output, const std::vector<double>& reference);
+
+    //largest absolute sample in the buffer, infinity if any sample isn't a finite number
+    double getPeakLevel(const juce::AudioBuffer<float>& buffer);
+
+    //what processBlock did that it shouldn't have, counted by RealtimeSafety on the thread that called it
+    struct Violations
+    {
+        juce::int64 allocations{ 0 }, deallocations{ 0 }, mutexLocks{ 0 };
+
+        Violations& operator+= (const Violations& other) noexcept;
+    };
+
+    //one processBlock call, and the violations it made
+    Violations processCountingViolations(SimpleEQAudioProcessor& processor, juce::AudioBuffer<float>& buffer);
+
+    //the background designer polls every millisecond or so, this gives it time to publish a change
+    void waitForDesigner();
+}
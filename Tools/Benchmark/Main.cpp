@@ -0,0 +1,1278 @@
+/*
+  ==============================================================================
+
+    Benchmark suite: drives SimpleEQAudioProcessor directly, without a host,
+    and reports the cost of processBlock as JSON so runs can be compared.
+
+    SimpleEQBenchmark [--quick] [--seconds 1.0] [--output results.json] [--fail-on-violations]
+
+    Suites:
+      processBlock     block sizes 16..4096, 44.1..192 kHz, every Slope
+                       combination, static and automated parameters
+      paths            MonoChain vs SIMD path at 2, 8 and 16 channels
+      pathEquivalence  the same noise through both paths for every Slope
+                       combination, the peak flat and boosted and the cut
+                       bands in the float filters or moved out to double,
+                       at 2 and 5 channels. Exits with 1 if the outputs differ
+                       by more than pathTolerance
+      smoothing        automated parameters at different smoothing sub-block sizes
+      oversampling     cost of each oversampling factor at 44.1 and 48 kHz
+      linearPhase      partitioned FIR convolution at 48 and 96 kHz
+      analyzer         audio thread cost of the spectrum analyzer, editor
+                       open vs closed
+      responseCurve    editor response curve at 1080p and 4K widths, every
+                       band vs the peak band only
+      state            save and restore of 1000 instances, binary vs XML
+      cutFilterDesign  cost of one Slope_48 cut design, JUCE's FilterDesign vs
+                       FilterCoefficients vs CutFilterTable
+      cutFilters       one cut band per Slope, the ProcessorChain of four
+                       bypassable IIR::Filters vs CutCascade
+      precision        cost of each PrecisionMode on float buffers, and of
+                       double buffers, for a well and a poorly conditioned low cut
+      precisionAccuracy
+                       error of the same cases against a long double reference
+                       cascade, in dB below the output
+      modulation       fast automation through the biquads, redesigned per block,
+                       per sub-block and per sample, against the state variable
+                       filters ramping every sample
+      filterEngineAccuracy
+                       state variable filters against the biquad reference for
+                       every Slope, so the magnitude responses can be compared
+      parametricBands  0 to 24 active parametric bands, with the engine prepared
+                       for 8 and for 24
+      dynamic          the dynamic peak on the input and on the sidechain against
+                       the static peak, with and without smoothing
+      idle             silent and playing input with idle detection on and off,
+                       plain, oversampled and linear phase
+      loadMeter        processBlock with the DspLoadMeter on and off, 16 to 512
+                       sample blocks, for its overhead
+      coefficientCache hit rate, evictions and table memory shared when 1, 8 and
+                       32 instances are prepared with the same or different settings
+
+    Every processBlock case reports ns/sample, p50/p99/max block time and the
+    allocations, deallocations and mutex locks made inside processBlock, counted
+    by RealtimeSafety, so this target is always built with
+    SIMPLEEQ_RT_SAFETY_CHECKS=1. --fail-on-violations exits with 1 if any case
+    made one, for CI.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include <numeric>
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/ResponseCurve.h"
+
+//==============================================================================
+#if ! SIMPLEEQ_RT_SAFETY_CHECKS
+ #error "The benchmark counts allocations through RealtimeSafety, build it with SIMPLEEQ_RT_SAFETY_CHECKS=1"
+#endif
+
+namespace
+{
+    using RealtimeSafety::ViolationType;
+
+    struct CaseConfig
+    {
+        int blockSize{ 512 };
+        double sampleRate{ 48000 };
+        int numChannels{ 2 };
+        Slope lowCutSlope{ Slope_12 }, highCutSlope{ Slope_12 };
+        bool automated{ false };
+        bool useSimd{ false };
+        int subBlockSize{ 32 };
+        int oversamplingOrder{ 0 };
+        bool linearPhase{ false };
+        bool analyzerOpen{ false };
+        float lowCutFreq{ 80.f };
+        float peakGain{ 6.f };
+        SimpleEQAudioProcessor::PrecisionMode precisionMode{ SimpleEQAudioProcessor::PrecisionMode::automatic };
+        bool doubleBuffers{ false };
+        SimpleEQAudioProcessor::FilterEngine filterEngine{ SimpleEQAudioProcessor::FilterEngine::biquad };
+        int numParametricBands{ maxParametricBands };
+        int numActiveBands{ 0 };
+        bool dynamic{ false };
+        bool sidechain{ false };
+        bool silentInput{ false };
+        bool idleDetection{ true };
+        bool loadMeter{ true };
+    };
+
+    struct CaseResult
+    {
+        double nsPerSample{ 0 };
+        double p50{ 0 }, p99{ 0 }, max{ 0 };     //block time in microseconds
+        juce::int64 allocations{ 0 }, deallocations{ 0 }, mutexLocks{ 0 };
+        int numBlocks{ 0 };
+        double tailSeconds{ 0 };
+        bool endedIdle{ false };
+    };
+
+    void setParameter(SimpleEQAudioProcessor& processor, const juce::String& parameterID, float value)
+    {
+        auto* parameter = processor.apvts.getParameter(parameterID);
+        jassert(parameter != nullptr);
+
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    std::unique_ptr<SimpleEQAudioProcessor> createProcessor(const CaseConfig& config)
+    {
+        auto processor = std::make_unique<SimpleEQAudioProcessor>();
+
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(juce::AudioChannelSet::canonicalChannelSet(config.numChannels));
+        layout.inputBuses.add(config.sidechain ? juce::AudioChannelSet::stereo() : juce::AudioChannelSet::disabled());
+        layout.outputBuses.add(juce::AudioChannelSet::canonicalChannelSet(config.numChannels));
+        processor->setBusesLayout(layout);
+
+        //settings that put every stage to work
+        setParameter(*processor, "LowCut Freq", config.lowCutFreq);
+        setParameter(*processor, "HighCut Freq", 12000.f);
+        setParameter(*processor, "Peak Freq", 1000.f);
+        setParameter(*processor, "Peak Gain", config.peakGain);
+        setParameter(*processor, "Peak Quality", 1.f);
+        setParameter(*processor, "LowCut Slope", (float) config.lowCutSlope);
+        setParameter(*processor, "HighCut Slope", (float) config.highCutSlope);
+        setParameter(*processor, "Oversampling", (float) config.oversamplingOrder);
+        setParameter(*processor, "Linear Phase", config.linearPhase ? 1.f : 0.f);
+
+        //a threshold the noise is well over, so the peak's gain is always moving
+        setParameter(*processor, "Dynamic", config.dynamic ? 1.f : 0.f);
+        setParameter(*processor, "Dynamic Sidechain", config.sidechain ? 1.f : 0.f);
+        setParameter(*processor, "Dynamic Threshold", -40.f);
+        setParameter(*processor, "Dynamic Attack", 1.f);
+        setParameter(*processor, "Dynamic Release", 50.f);
+
+        //the first numActiveBands parametric bands cycle through the types, the rest stay off
+        for (int band = 0; band < config.numActiveBands; ++band)
+        {
+            setParameter(*processor, getBandParameterID(band, "Type"), (float) (1 + band % 4));
+            setParameter(*processor, getBandParameterID(band, "Gain"), band % 2 == 0 ? 3.f : -3.f);
+        }
+
+        processor->setUseSimdProcessing(config.useSimd);
+        processor->setSmoothingSubBlockSize(config.subBlockSize);
+        processor->setPrecisionMode(config.precisionMode);
+        processor->setFilterEngine(config.filterEngine);
+        processor->setNumParametricBands(config.numParametricBands);
+        processor->setIdleDetection(config.idleDetection);
+        processor->getLoadMeter().setEnabled(config.loadMeter);
+
+        //what an open editor does, the analyzer's worker runs alongside the case as it would in a host
+        processor->getSpectrumAnalyzer().setEnabled(config.analyzerOpen);
+
+        //the host picks the precision before it prepares the processor
+        if (config.doubleBuffers)
+            processor->setProcessingPrecision(juce::AudioProcessor::doublePrecision);
+
+        processor->setNonRealtime(true);
+        processor->setRateAndBufferSizeDetails(config.sampleRate, config.blockSize);
+        processor->prepareToPlay(config.sampleRate, config.blockSize);
+
+        return processor;
+    }
+
+    //slow sweeps over the continuous parameters, like a host playing back automation
+    void automate(SimpleEQAudioProcessor& processor, double timeInSeconds)
+    {
+        auto phase = std::sin(juce::MathConstants<double>::twoPi * 0.5 * timeInSeconds);
+        auto position = (float) (0.5 + 0.5 * phase);
+
+        setParameter(processor, "LowCut Freq", 20.f * std::pow(25.f, position));
+        setParameter(processor, "Peak Freq", 200.f * std::pow(40.f, position));
+        setParameter(processor, "Peak Gain", -12.f + 24.f * position);
+    }
+
+    double getPercentile(const std::vector<double>& sortedValues, double percentile)
+    {
+        auto index = (size_t) juce::jlimit(0.0, (double) sortedValues.size() - 1, std::ceil(percentile * (double) sortedValues.size()) - 1);
+        return sortedValues[index];
+    }
+
+    template <typename SampleType>
+    CaseResult runCase(const CaseConfig& config, double seconds)
+    {
+        auto processor = createProcessor(config);
+
+        auto numBlocks = juce::jmax(64, (int) (seconds * config.sampleRate / config.blockSize));
+        constexpr int numWarmUpBlocks = 16;
+
+        //noise source copied in before every block so repeated filtering never decays into denormals
+        //the buffer has the sidechain's channels after the main ones when there is one
+        auto numBufferChannels = juce::jmax(processor->getTotalNumInputChannels(), processor->getTotalNumOutputChannels());
+        juce::AudioBuffer<SampleType> source(numBufferChannels, config.blockSize);
+        juce::AudioBuffer<SampleType> buffer(numBufferChannels, config.blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1234);
+
+        //a silent source is the idle track of a big session, the warm up blocks give the filters time to ring down
+        for (int ch = 0; ch < numBufferChannels; ++ch)
+            for (int i = 0; i < config.blockSize; ++i)
+                source.setSample(ch, i, config.silentInput ? SampleType(0) : (SampleType) (random.nextFloat() * 2.f - 1.f));
+
+        std::vector<double> blockTimes;
+        blockTimes.reserve((size_t) numBlocks);
+
+        CaseResult result;
+        auto ticksPerSecond = (double) juce::Time::getHighResolutionTicksPerSecond();
+
+        for (int block = -numWarmUpBlocks; block < numBlocks; ++block)
+        {
+            buffer.makeCopyOf(source, true);
+
+            if (config.automated)
+                automate(*processor, (double) (block + numWarmUpBlocks) * config.blockSize / config.sampleRate);
+
+            auto allocationsBefore = RealtimeSafety::getThreadViolationCount(ViolationType::allocation);
+            auto deallocationsBefore = RealtimeSafety::getThreadViolationCount(ViolationType::deallocation);
+            auto mutexLocksBefore = RealtimeSafety::getThreadViolationCount(ViolationType::mutexLock);
+            auto start = juce::Time::getHighResolutionTicks();
+
+            processor->processBlock(buffer, midi);
+
+            auto end = juce::Time::getHighResolutionTicks();
+
+            if (block < 0)
+                continue;
+
+            result.allocations += RealtimeSafety::getThreadViolationCount(ViolationType::allocation) - allocationsBefore;
+            result.deallocations += RealtimeSafety::getThreadViolationCount(ViolationType::deallocation) - deallocationsBefore;
+            result.mutexLocks += RealtimeSafety::getThreadViolationCount(ViolationType::mutexLock) - mutexLocksBefore;
+            blockTimes.push_back((double) (end - start) / ticksPerSecond * 1.0e6);
+        }
+
+        result.tailSeconds = processor->getTailLengthSeconds();
+        result.endedIdle = processor->isIdle();
+
+        processor->releaseResources();
+
+        auto totalMicroseconds = std::accumulate(blockTimes.begin(), blockTimes.end(), 0.0);
+        std::sort(blockTimes.begin(), blockTimes.end());
+
+        result.numBlocks = numBlocks;
+        result.nsPerSample = totalMicroseconds * 1.0e3 / ((double) numBlocks * config.blockSize);
+        result.p50 = getPercentile(blockTimes, 0.5);
+        result.p99 = getPercentile(blockTimes, 0.99);
+        result.max = blockTimes.back();
+
+        return result;
+    }
+
+    juce::String getPrecisionName(const CaseConfig& config)
+    {
+        if (config.doubleBuffers)
+            return "doubleBuffers";
+
+        switch (config.precisionMode)
+        {
+            case SimpleEQAudioProcessor::PrecisionMode::singlePrecision:    return "single";
+            case SimpleEQAudioProcessor::PrecisionMode::automatic:          return "automatic";
+            case SimpleEQAudioProcessor::PrecisionMode::doublePrecision:    return "double";
+        }
+
+        return {};
+    }
+
+    juce::String getEngineName(const CaseConfig& config)
+    {
+        return config.filterEngine == SimpleEQAudioProcessor::FilterEngine::stateVariable ? "stateVariable" : "biquad";
+    }
+
+    juce::var toVar(const CaseConfig& config, const CaseResult& result)
+    {
+        auto* object = new juce::DynamicObject();
+
+        object->setProperty("blockSize", config.blockSize);
+        object->setProperty("sampleRate", config.sampleRate);
+        object->setProperty("channels", config.numChannels);
+        object->setProperty("lowCutSlope", 12 * (config.lowCutSlope + 1));
+        object->setProperty("highCutSlope", 12 * (config.highCutSlope + 1));
+        object->setProperty("automated", config.automated);
+        object->setProperty("path", config.useSimd ? "simd" : "monoChain");
+        object->setProperty("subBlockSize", config.subBlockSize);
+        object->setProperty("oversampling", 1 << config.oversamplingOrder);
+        object->setProperty("linearPhase", config.linearPhase);
+        object->setProperty("analyzerOpen", config.analyzerOpen);
+        object->setProperty("lowCutFreq", config.lowCutFreq);
+        object->setProperty("peakGain", config.peakGain);
+        object->setProperty("precision", getPrecisionName(config));
+        object->setProperty("engine", getEngineName(config));
+        object->setProperty("parametricBands", config.numParametricBands);
+        object->setProperty("activeBands", config.numActiveBands);
+        object->setProperty("dynamic", config.dynamic ? (config.sidechain ? "sidechain" : "input") : "off");
+        object->setProperty("input", config.silentInput ? "silent" : "noise");
+        object->setProperty("idleDetection", config.idleDetection);
+        object->setProperty("loadMeter", config.loadMeter);
+
+        object->setProperty("blocks", result.numBlocks);
+        object->setProperty("nsPerSample", result.nsPerSample);
+        object->setProperty("blockTimeP50Us", result.p50);
+        object->setProperty("blockTimeP99Us", result.p99);
+        object->setProperty("blockTimeMaxUs", result.max);
+        object->setProperty("allocations", result.allocations);
+        object->setProperty("allocationsPerBlock", (double) result.allocations / result.numBlocks);
+        object->setProperty("deallocations", result.deallocations);
+        object->setProperty("mutexLocks", result.mutexLocks);
+        object->setProperty("tailSeconds", result.tailSeconds);
+        object->setProperty("endedIdle", result.endedIdle);
+
+        return juce::var(object);
+    }
+
+    juce::var runCases(const std::vector<CaseConfig>& configs, double seconds, const juce::String& suiteName, juce::int64& numViolations)
+    {
+        juce::var results;
+
+        for (size_t i = 0; i < configs.size(); ++i)
+        {
+            std::cerr << suiteName << " " << (i + 1) << "/" << configs.size() << "\r" << std::flush;
+
+            auto result = configs[i].doubleBuffers ? runCase<double>(configs[i], seconds)
+                                                   : runCase<float>(configs[i], seconds);
+            numViolations += result.allocations + result.deallocations + result.mutexLocks;
+            results.append(toVar(configs[i], result));
+        }
+
+        std::cerr << std::endl;
+        return results;
+    }
+
+    //==============================================================================
+    std::vector<CaseConfig> getProcessBlockCases(bool quick)
+    {
+        std::vector<int> blockSizes = quick ? std::vector<int>{ 64, 512, 4096 }
+                                            : std::vector<int>{ 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+        std::vector<double> sampleRates = quick ? std::vector<double>{ 48000, 192000 }
+                                                : std::vector<double>{ 44100, 48000, 88200, 96000, 176400, 192000 };
+        std::vector<Slope> slopes = quick ? std::vector<Slope>{ Slope_12, Slope_48 }
+                                          : std::vector<Slope>{ Slope_12, Slope_24, Slope_36, Slope_48 };
+
+        std::vector<CaseConfig> configs;
+
+        for (auto blockSize : blockSizes)
+            for (auto sampleRate : sampleRates)
+                for (auto lowCutSlope : slopes)
+                    for (auto highCutSlope : slopes)
+                        for (auto automated : { false, true })
+                        {
+                            CaseConfig config;
+                            config.blockSize = blockSize;
+                            config.sampleRate = sampleRate;
+                            config.lowCutSlope = lowCutSlope;
+                            config.highCutSlope = highCutSlope;
+                            config.automated = automated;
+                            configs.push_back(config);
+                        }
+
+        return configs;
+    }
+
+    std::vector<CaseConfig> getPathCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto numChannels : { 2, 8, 16 })
+            for (auto useSimd : { false, true })
+            {
+                CaseConfig config;
+                config.numChannels = numChannels;
+                config.lowCutSlope = Slope_48;
+                config.highCutSlope = Slope_48;
+                config.useSimd = useSimd;
+                configs.push_back(config);
+            }
+
+        return configs;
+    }
+
+    //every combination of stages the two paths can leave out: the cut sections a Slope doesn't use,
+    //a flat peak, and the cut bands that run in double rather than in the float filters
+    //5 channels leave lanes of the last SIMD cascade empty
+    std::vector<CaseConfig> getPathEquivalenceCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto numChannels : { 2, 5 })
+            for (auto lowCutSlope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+                for (auto highCutSlope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+                    for (auto peakGain : { 0.f, 6.f })
+                        for (auto precisionMode : { SimpleEQAudioProcessor::PrecisionMode::singlePrecision,
+                                                    SimpleEQAudioProcessor::PrecisionMode::doublePrecision })
+                        {
+                            CaseConfig config;
+                            config.numChannels = numChannels;
+                            config.lowCutSlope = lowCutSlope;
+                            config.highCutSlope = highCutSlope;
+                            config.peakGain = peakGain;
+                            config.precisionMode = precisionMode;
+                            configs.push_back(config);
+                        }
+
+        return configs;
+    }
+
+    std::vector<CaseConfig> getSmoothingCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto subBlockSize : { 0, 8, 16, 32, 64, 128 })
+        {
+            CaseConfig config;
+            config.lowCutSlope = Slope_48;
+            config.highCutSlope = Slope_48;
+            config.automated = true;
+            config.subBlockSize = subBlockSize;
+            configs.push_back(config);
+        }
+
+        return configs;
+    }
+
+    std::vector<CaseConfig> getOversamplingCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto sampleRate : { 44100.0, 48000.0 })
+            for (int order = 0; order <= SimpleEQAudioProcessor::maxOversamplingOrder; ++order)
+            {
+                CaseConfig config;
+                config.sampleRate = sampleRate;
+                config.lowCutSlope = Slope_48;
+                config.highCutSlope = Slope_48;
+                config.oversamplingOrder = order;
+                configs.push_back(config);
+            }
+
+        return configs;
+    }
+
+    std::vector<CaseConfig> getLinearPhaseCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto sampleRate : { 48000.0, 96000.0 })
+            for (auto blockSize : { 64, 512, 2048 })
+                for (auto automated : { false, true })
+                {
+                    CaseConfig config;
+                    config.sampleRate = sampleRate;
+                    config.blockSize = blockSize;
+                    config.lowCutSlope = Slope_48;
+                    config.highCutSlope = Slope_48;
+                    config.automated = automated;
+                    config.linearPhase = true;
+                    configs.push_back(config);
+                }
+
+        return configs;
+    }
+
+    std::vector<CaseConfig> getAnalyzerCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto blockSize : { 32, 128, 512, 2048 })
+            for (auto analyzerOpen : { false, true })
+            {
+                CaseConfig config;
+                config.blockSize = blockSize;
+                config.lowCutSlope = Slope_48;
+                config.highCutSlope = Slope_48;
+                config.analyzerOpen = analyzerOpen;
+                configs.push_back(config);
+            }
+
+        return configs;
+    }
+
+    //a Slope_48 low cut float handles fine (80 Hz at 48 kHz) and one it doesn't (20 Hz at 192 kHz),
+    //through every PrecisionMode on float buffers and through double buffers
+    std::vector<CaseConfig> getPrecisionCases()
+    {
+        using PrecisionMode = SimpleEQAudioProcessor::PrecisionMode;
+
+        std::vector<CaseConfig> configs;
+
+        for (auto [sampleRate, lowCutFreq] : { std::pair<double, float>{ 48000, 80.f }, std::pair<double, float>{ 192000, 20.f } })
+            for (auto doubleBuffers : { false, true })
+                for (auto precisionMode : { PrecisionMode::singlePrecision, PrecisionMode::automatic, PrecisionMode::doublePrecision })
+                {
+                    //double buffers always run in double, one case is enough
+                    if (doubleBuffers && precisionMode != PrecisionMode::automatic)
+                        continue;
+
+                    CaseConfig config;
+                    config.sampleRate = sampleRate;
+                    config.lowCutFreq = lowCutFreq;
+                    config.lowCutSlope = Slope_48;
+                    config.highCutSlope = Slope_48;
+                    config.subBlockSize = 0;
+                    config.precisionMode = precisionMode;
+                    config.doubleBuffers = doubleBuffers;
+                    configs.push_back(config);
+                }
+
+        return configs;
+    }
+
+    //the low cut swept 20..500 Hz, the peak 200..8000 Hz and its gain +-12 dB every two seconds
+    //subBlockSize 0 redesigns the biquads once per block, 1 redesigns them every sample
+    std::vector<CaseConfig> getModulationCases()
+    {
+        using FilterEngine = SimpleEQAudioProcessor::FilterEngine;
+
+        std::vector<CaseConfig> configs;
+
+        for (auto slope : { Slope_12, Slope_48 })
+        {
+            for (auto subBlockSize : { 0, 32, 8, 1 })
+            {
+                CaseConfig config;
+                config.lowCutSlope = slope;
+                config.highCutSlope = slope;
+                config.automated = true;
+                config.subBlockSize = subBlockSize;
+                configs.push_back(config);
+            }
+
+            //the state variable filters ramp every sample whatever the sub-block size
+            CaseConfig config;
+            config.lowCutSlope = slope;
+            config.highCutSlope = slope;
+            config.automated = true;
+            config.filterEngine = FilterEngine::stateVariable;
+            configs.push_back(config);
+        }
+
+        return configs;
+    }
+
+    //the cost should follow the bands that are switched on, not how many the engine was prepared for
+    std::vector<CaseConfig> getParametricBandCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto numParametricBands : { 8, maxParametricBands })
+            for (auto numActiveBands : { 0, 1, 4, 8, 16, 24 })
+                if (numActiveBands <= numParametricBands)
+                    for (auto numChannels : { 2, 6 })
+                    {
+                        CaseConfig config;
+                        config.numParametricBands = numParametricBands;
+                        config.numActiveBands = numActiveBands;
+                        config.numChannels = numChannels;
+                        configs.push_back(config);
+                    }
+
+        return configs;
+    }
+
+    //the dynamic peak's detector and gain-only updates against the static peak, with and without smoothing
+    std::vector<CaseConfig> getDynamicCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto subBlockSize : { 0, 32 })
+            for (auto doubleBuffers : { false, true })
+                for (auto [dynamic, sidechain] : { std::pair{ false, false }, std::pair{ true, false }, std::pair{ true, true } })
+                {
+                    CaseConfig config;
+                    config.subBlockSize = subBlockSize;
+                    config.doubleBuffers = doubleBuffers;
+                    config.dynamic = dynamic;
+                    config.sidechain = sidechain;
+                    configs.push_back(config);
+                }
+
+        return configs;
+    }
+
+    //a silent track with and without idle detection, and a playing one to show the peak scan costs next to nothing
+    std::vector<CaseConfig> getIdleCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto [oversamplingOrder, linearPhase] : { std::pair{ 0, false }, std::pair{ 2, false }, std::pair{ 0, true } })
+            for (auto silentInput : { true, false })
+                for (auto idleDetection : { false, true })
+                {
+                    CaseConfig config;
+                    config.lowCutSlope = Slope_48;
+                    config.highCutSlope = Slope_48;
+                    config.oversamplingOrder = oversamplingOrder;
+                    config.linearPhase = linearPhase;
+                    config.silentInput = silentInput;
+                    config.idleDetection = idleDetection;
+                    configs.push_back(config);
+                }
+
+        return configs;
+    }
+
+    //what the load meter's counter reads cost, it should stay under 1% even for small blocks
+    std::vector<CaseConfig> getLoadMeterCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto blockSize : { 16, 64, 512 })
+            for (auto subBlockSize : { 0, 32 })
+                for (auto loadMeter : { false, true })
+                {
+                    CaseConfig config;
+                    config.blockSize = blockSize;
+                    config.subBlockSize = subBlockSize;
+                    config.automated = true;
+                    config.loadMeter = loadMeter;
+                    configs.push_back(config);
+                }
+
+        return configs;
+    }
+
+    //static settings, so both engines should land on the same response
+    std::vector<CaseConfig> getFilterEngineAccuracyCases()
+    {
+        std::vector<CaseConfig> configs;
+
+        for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+            for (auto doubleBuffers : { false, true })
+            {
+                CaseConfig config;
+                config.lowCutSlope = slope;
+                config.highCutSlope = slope;
+                config.subBlockSize = 0;
+                config.doubleBuffers = doubleBuffers;
+                config.filterEngine = SimpleEQAudioProcessor::FilterEngine::stateVariable;
+                configs.push_back(config);
+            }
+
+        return configs;
+    }
+
+    //==============================================================================
+    //the designs the processor uses, run in long double transposed direct form II
+    class ReferenceCascade
+    {
+    public:
+        ReferenceCascade(const ChainSettings& settings, double sampleRate)
+        {
+            auto lowCut = makeLowCutCoefficients(settings, sampleRate);
+            auto highCut = makeHighCutCoefficients(settings, sampleRate);
+
+            for (int i = 0; i < getNumCutSections(settings.lowCutSlope); ++i)
+                stages.push_back({ lowCut[(size_t) i] });
+
+            stages.push_back({ makePeakCoefficients(settings, sampleRate) });
+
+            for (int i = 0; i < getNumCutSections(settings.highCutSlope); ++i)
+                stages.push_back({ highCut[(size_t) i] });
+        }
+
+        long double process(long double x) noexcept
+        {
+            for (auto& stage : stages)
+            {
+                const auto& c = stage.coefficients;
+
+                auto y = c[0] * x + stage.s1;
+                stage.s1 = c[1] * x - c[3] * y + stage.s2;
+                stage.s2 = c[2] * x - c[4] * y;
+                x = y;
+            }
+
+            return x;
+        }
+
+    private:
+        struct Stage
+        {
+            BiquadCoefficients coefficients;
+            long double s1{ 0 }, s2{ 0 };
+        };
+
+        std::vector<Stage> stages;
+    };
+
+    //runs a mono signal through the processor in blocks and returns the output
+    template <typename SampleType>
+    std::vector<double> render(SimpleEQAudioProcessor& processor, const std::vector<float>& input, int blockSize)
+    {
+        juce::AudioBuffer<SampleType> buffer(1, blockSize);
+        juce::MidiBuffer midi;
+        std::vector<double> output;
+        output.reserve(input.size());
+
+        for (size_t start = 0; start < input.size(); start += (size_t) blockSize)
+        {
+            auto numSamples = (int) juce::jmin((size_t) blockSize, input.size() - start);
+            buffer.setSize(1, numSamples, false, false, true);
+
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(0, i, (SampleType) input[start + (size_t) i]);
+
+            processor.processBlock(buffer, midi);
+
+            for (int i = 0; i < numSamples; ++i)
+                output.push_back((double) buffer.getSample(0, i));
+        }
+
+        return output;
+    }
+
+    //how far the output strays from the reference, as error energy over output energy in dB
+    //the input is white noise in float, so every case starts from exactly the same samples
+    juce::var runAccuracyCases(const std::vector<CaseConfig>& configs)
+    {
+        constexpr double seconds = 2.0;
+
+        juce::var results;
+
+        for (auto config : configs)
+        {
+            config.numChannels = 1;
+
+            auto processor = createProcessor(config);
+
+            std::vector<float> input((size_t) (seconds * config.sampleRate));
+            juce::Random random(1234);
+
+            for (auto& sample : input)
+                sample = random.nextFloat() * 2.f - 1.f;
+
+            auto output = config.doubleBuffers ? render<double>(*processor, input, config.blockSize)
+                                               : render<float>(*processor, input, config.blockSize);
+
+            processor->releaseResources();
+
+            ReferenceCascade reference(getChainSettings(processor->apvts), config.sampleRate);
+            long double errorEnergy = 0, referenceEnergy = 0;
+
+            for (size_t i = 0; i < input.size(); ++i)
+            {
+                auto expected = reference.process(input[i]);
+                auto error = (long double) output[i] - expected;
+
+                errorEnergy += error * error;
+                referenceEnergy += expected * expected;
+            }
+
+            auto* object = new juce::DynamicObject();
+            object->setProperty("sampleRate", config.sampleRate);
+            object->setProperty("lowCutFreq", config.lowCutFreq);
+            object->setProperty("lowCutSlope", 12 * (config.lowCutSlope + 1));
+            object->setProperty("highCutSlope", 12 * (config.highCutSlope + 1));
+            object->setProperty("precision", getPrecisionName(config));
+            object->setProperty("engine", getEngineName(config));
+            object->setProperty("errorDb", juce::Decibels::gainToDecibels((double) std::sqrt(errorEnergy / referenceEnergy), -300.0));
+            results.append(juce::var(object));
+        }
+
+        return results;
+    }
+
+    //largest sample difference allowed between the MonoChain and SIMD paths, -80 dB below full scale
+    //both run the same float transposed direct form II, so only rounding and fused multiply-adds should separate them
+    constexpr double pathTolerance = 1.0e-4;
+
+    //noise through every channel in blocks, the same samples on every call, and the output of every channel
+    std::vector<float> renderNoise(SimpleEQAudioProcessor& processor, int numChannels, int numSamples, int blockSize)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1234);
+        std::vector<float> output;
+        output.reserve((size_t) (numChannels * numSamples));
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(ch, i, random.nextFloat() * 2.f - 1.f);
+
+            processor.processBlock(buffer, midi);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    output.push_back(buffer.getSample(ch, i));
+        }
+
+        return output;
+    }
+
+    //renders each case through both paths and compares them sample by sample
+    juce::var runPathEquivalenceCases(const std::vector<CaseConfig>& configs, int& numMismatches)
+    {
+        constexpr double seconds = 0.5;
+
+        juce::var results;
+
+        for (size_t i = 0; i < configs.size(); ++i)
+        {
+            std::cerr << "pathEquivalence " << (i + 1) << "/" << configs.size() << "\r" << std::flush;
+
+            auto config = configs[i];
+            auto numSamples = (int) (seconds * config.sampleRate);
+            std::array<std::vector<float>, 2> outputs;
+
+            for (auto useSimd : { false, true })
+            {
+                config.useSimd = useSimd;
+
+                auto processor = createProcessor(config);
+                outputs[useSimd ? 1 : 0] = renderNoise(*processor, config.numChannels, numSamples, config.blockSize);
+                processor->releaseResources();
+            }
+
+            auto maxDifference = 0.0;
+
+            //a NaN in either output counts as an infinite difference, jmax would skip over it
+            for (size_t s = 0; s < outputs[0].size(); ++s)
+            {
+                auto difference = std::abs((double) outputs[0][s] - (double) outputs[1][s]);
+                maxDifference = std::isnan(difference) ? std::numeric_limits<double>::infinity() : juce::jmax(maxDifference, difference);
+            }
+
+            auto passed = maxDifference <= pathTolerance;
+
+            if (! passed)
+                ++numMismatches;
+
+            auto* object = new juce::DynamicObject();
+            object->setProperty("channels", config.numChannels);
+            object->setProperty("lowCutSlope", 12 * (config.lowCutSlope + 1));
+            object->setProperty("highCutSlope", 12 * (config.highCutSlope + 1));
+            object->setProperty("peakGain", config.peakGain);
+            object->setProperty("precision", getPrecisionName(config));
+            object->setProperty("maxDifference", maxDifference);
+            object->setProperty("tolerance", pathTolerance);
+            object->setProperty("passed", passed);
+            results.append(juce::var(object));
+        }
+
+        std::cerr << std::endl;
+        return results;
+    }
+
+    //==============================================================================
+    //ns per Slope_48 low cut design across the whole frequency range
+    template <typename DesignFunction>
+    juce::var timeDesign(const juce::String& method, DesignFunction&& design)
+    {
+        constexpr int numRounds = 20;
+        float checksum = 0;
+
+        auto allocationsBefore = RealtimeSafety::getThreadViolationCount(ViolationType::allocation);
+        auto start = juce::Time::getHighResolutionTicks();
+
+        {
+            //counted the same way as processBlock, as if the design ran on the audio thread
+            RealtimeSafety::ScopedAudioThread audioThread;
+
+            for (int round = 0; round < numRounds; ++round)
+                for (int frequency = CutFilterTable::minFrequency; frequency <= CutFilterTable::maxFrequency; ++frequency)
+                    checksum += design((float) frequency);
+        }
+
+        auto end = juce::Time::getHighResolutionTicks();
+
+        auto numDesigns = (double) numRounds * (CutFilterTable::maxFrequency - CutFilterTable::minFrequency + 1);
+        auto seconds = juce::Time::highResolutionTicksToSeconds(end - start);
+
+        auto* object = new juce::DynamicObject();
+        object->setProperty("method", method);
+        object->setProperty("nsPerDesign", seconds * 1.0e9 / numDesigns);
+        object->setProperty("allocationsPerDesign", (double) (RealtimeSafety::getThreadViolationCount(ViolationType::allocation) - allocationsBefore) / numDesigns);
+        object->setProperty("checksum", checksum);
+
+        return juce::var(object);
+    }
+
+    juce::var runCutFilterDesignCases()
+    {
+        constexpr double sampleRate = 48000;
+
+        CutFilterTable table;
+        table.prepare(sampleRate);
+
+        ChainSettings settings;
+        settings.lowCutSlope = Slope_48;
+
+        juce::var results;
+
+        results.append(timeDesign("juceFilterDesign", [&](float frequency)
+        {
+            auto coefficients = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(frequency, sampleRate, 8);
+            return coefficients[0]->coefficients[0];
+        }));
+
+        results.append(timeDesign("filterCoefficients", [&](float frequency)
+        {
+            settings.lowCutFreq = frequency;
+            return makeLowCutCoefficients(settings, sampleRate)[0][0];
+        }));
+
+        results.append(timeDesign("cutFilterTable", [&](float frequency)
+        {
+            return table.makeLowCutCoefficients(frequency, Slope_48)[0][0];
+        }));
+
+        auto* footprint = new juce::DynamicObject();
+        footprint->setProperty("method", "cutFilterTableFootprint");
+        footprint->setProperty("bytes", (juce::int64) table.getMemoryFootprint());
+        results.append(juce::var(footprint));
+
+        return results;
+    }
+
+    //==============================================================================
+    //ns per sample of one cut band at each Slope, the chain the MonoChain used to hold against the CutCascade
+    juce::var runCutFilterCases(double seconds)
+    {
+        using Filter = juce::dsp::IIR::Filter<float>;
+        using ProcessorChainCut = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
+
+        constexpr double sampleRate = 48000;
+        constexpr int blockSize = 512;
+
+        juce::dsp::ProcessSpec spec{ sampleRate, (juce::uint32) blockSize, 1 };
+        auto numBlocks = juce::jmax(64, (int) (seconds * sampleRate / blockSize));
+
+        juce::AudioBuffer<float> source(1, blockSize);
+        juce::Random random(1234);
+
+        for (int i = 0; i < blockSize; ++i)
+            source.setSample(0, i, random.nextFloat() * 2.f - 1.f);
+
+        //processes the same noise block numBlocks times and leaves the last output in the buffer
+        auto time = [&](auto& filter, juce::AudioBuffer<float>& buffer)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                buffer.makeCopyOf(source, true);
+
+                juce::dsp::AudioBlock<float> audioBlock(buffer);
+                juce::dsp::ProcessContextReplacing<float> context(audioBlock);
+                filter.process(context);
+            }
+
+            auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+            return elapsed * 1.0e9 / ((double) numBlocks * blockSize);
+        };
+
+        juce::var results;
+
+        for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+        {
+            ChainSettings settings;
+            settings.lowCutFreq = 80.f;
+            settings.lowCutSlope = slope;
+
+            auto coefficients = makeLowCutCoefficients(settings, sampleRate);
+            auto numSections = getNumCutSections(slope);
+
+            //set up the way updateCutFilter used to: a coefficient object per stage, the unused stages bypassed
+            ProcessorChainCut processorChain;
+
+            auto setStage = [&coefficients](Filter& filter, size_t index)
+            {
+                const auto& c = coefficients[index];
+                filter.coefficients = new juce::dsp::IIR::Coefficients<float>((float) c[0], (float) c[1], (float) c[2],
+                                                                              1.f, (float) c[3], (float) c[4]);
+            };
+
+            setStage(processorChain.get<0>(), 0);
+            setStage(processorChain.get<1>(), 1);
+            setStage(processorChain.get<2>(), 2);
+            setStage(processorChain.get<3>(), 3);
+
+            processorChain.setBypassed<1>(numSections < 2);
+            processorChain.setBypassed<2>(numSections < 3);
+            processorChain.setBypassed<3>(numSections < 4);
+            processorChain.prepare(spec);
+
+            CutCascade<float> cascade;
+            cascade.prepare(spec);
+            cascade.setCoefficients(coefficients, slope);
+
+            juce::AudioBuffer<float> processorChainOutput, cascadeOutput;
+            auto processorChainNs = time(processorChain, processorChainOutput);
+            auto cascadeNs = time(cascade, cascadeOutput);
+
+            //the arithmetic is the same, so the outputs should be too
+            float maxDifference = 0;
+
+            for (int i = 0; i < blockSize; ++i)
+                maxDifference = juce::jmax(maxDifference, std::abs(processorChainOutput.getSample(0, i) - cascadeOutput.getSample(0, i)));
+
+            auto* object = new juce::DynamicObject();
+            object->setProperty("slope", 12 * (slope + 1));
+            object->setProperty("processorChainNsPerSample", processorChainNs);
+            object->setProperty("cutCascadeNsPerSample", cascadeNs);
+            object->setProperty("speedup", processorChainNs / cascadeNs);
+            object->setProperty("maxDifference", maxDifference);
+            results.append(juce::var(object));
+        }
+
+        return results;
+    }
+
+    //==============================================================================
+    //us per response curve update, evaluated the way ResponseCurveComponent does after a parameter change
+    juce::var runResponseCurveCases()
+    {
+        constexpr double sampleRate = 48000;
+        constexpr int numRounds = 200;
+
+        ChainSettings settings;
+        settings.lowCutFreq = 80.f;
+        settings.highCutFreq = 12000.f;
+        settings.peakFreq = 1000.f;
+        settings.peakGainInDecibels = 6.f;
+        settings.lowCutSlope = Slope_48;
+        settings.highCutSlope = Slope_48;
+
+        FilterCoefficientSet coefficientSet;
+        coefficientSet.lowCut = makeLowCutCoefficients(settings, sampleRate);
+        coefficientSet.peak = makePeakCoefficients(settings, sampleRate);
+        coefficientSet.highCut = makeHighCutCoefficients(settings, sampleRate);
+        coefficientSet.lowCutSlope = Slope_48;
+        coefficientSet.highCutSlope = Slope_48;
+
+        juce::var results;
+
+        for (auto width : { 1920, 3840 })
+            for (auto bands : { (int) ParameterCache::allBands, (int) ParameterCache::peakBand })
+            {
+                ResponseCurve curve;
+                curve.prepare(width, sampleRate);
+                curve.update(coefficientSet, ParameterCache::allBands);
+
+                auto start = juce::Time::getHighResolutionTicks();
+
+                for (int round = 0; round < numRounds; ++round)
+                    curve.update(coefficientSet, bands);
+
+                auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+                auto* object = new juce::DynamicObject();
+                object->setProperty("width", width);
+                object->setProperty("bands", bands == ParameterCache::allBands ? "all" : "peak");
+                object->setProperty("usPerUpdate", seconds * 1.0e6 / numRounds);
+                object->setProperty("checksum", curve.getDecibels()[(size_t) width / 2]);
+                results.append(juce::var(object));
+            }
+
+        return results;
+    }
+
+    //==============================================================================
+    //instances with the same settings should find their designs already in the cache and share one cut filter table
+    juce::var runCoefficientCacheCases()
+    {
+        //holds the cache between the cases, so the counters keep going
+        juce::SharedResourcePointer<CoefficientCache> cache;
+        juce::var results;
+
+        for (auto numInstances : { 1, 8, 32 })
+            for (auto sharedSettings : { true, false })
+                for (auto useTable : { false, true })
+                {
+                    auto before = cache->getStatistics();
+                    auto start = juce::Time::getHighResolutionTicks();
+
+                    std::vector<std::unique_ptr<SimpleEQAudioProcessor>> processors;
+
+                    for (int i = 0; i < numInstances; ++i)
+                    {
+                        //different settings only move the low cut, the peak and high cut are still shared
+                        CaseConfig config;
+                        config.lowCutFreq = sharedSettings ? 80.f : 80.f + (float) i;
+
+                        processors.push_back(createProcessor(config));
+
+                        if (useTable)
+                            processors.back()->setUseCutFilterTable(true);
+                    }
+
+                    auto end = juce::Time::getHighResolutionTicks();
+                    auto after = cache->getStatistics();
+
+                    auto lookups = after.lookups - before.lookups;
+                    auto hits = after.hits - before.hits;
+
+                    auto* object = new juce::DynamicObject();
+                    object->setProperty("instances", numInstances);
+                    object->setProperty("sharedSettings", sharedSettings);
+                    object->setProperty("cutFilterTable", useTable);
+                    object->setProperty("prepareMs", juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e3);
+                    object->setProperty("lookups", (juce::int64) lookups);
+                    object->setProperty("hits", (juce::int64) hits);
+                    object->setProperty("hitRate", lookups > 0 ? (double) hits / (double) lookups : 0.0);
+                    object->setProperty("evictions", (juce::int64) (after.evictions - before.evictions));
+                    object->setProperty("entries", after.numEntries);
+                    object->setProperty("cacheBytes", (juce::int64) after.cacheBytes);
+                    object->setProperty("tables", after.numTables);
+                    object->setProperty("tableBytes", (juce::int64) after.tableBytes);
+                    object->setProperty("bytesSaved", (juce::int64) after.bytesSaved);
+                    results.append(juce::var(object));
+
+                    for (auto& processor : processors)
+                        processor->releaseResources();
+                }
+
+        return results;
+    }
+
+    //==============================================================================
+    //save and restore time for a session's worth of instances, restoring into instances still at their defaults
+    juce::var runStateCases()
+    {
+        constexpr int numInstances = 1000;
+
+        std::vector<std::unique_ptr<SimpleEQAudioProcessor>> sources, targets;
+        juce::Random random(1234);
+
+        for (int i = 0; i < numInstances; ++i)
+        {
+            sources.push_back(std::make_unique<SimpleEQAudioProcessor>());
+            targets.push_back(std::make_unique<SimpleEQAudioProcessor>());
+
+            for (auto* parameter : sources.back()->getParameters())
+                parameter->setValueNotifyingHost(random.nextFloat());
+        }
+
+        auto resetTargets = [&targets]
+        {
+            for (auto& target : targets)
+                for (auto* parameter : target->getParameters())
+                    parameter->setValueNotifyingHost(parameter->getDefaultValue());
+        };
+
+        juce::var results;
+
+        for (auto format : { StateSerialization::Format::binary, StateSerialization::Format::xml })
+        {
+            std::vector<juce::MemoryBlock> states((size_t) numInstances);
+            resetTargets();
+
+            auto saveStart = juce::Time::getHighResolutionTicks();
+
+            for (size_t i = 0; i < sources.size(); ++i)
+            {
+                if (format == StateSerialization::Format::binary)
+                    StateSerialization::writeBinary(*sources[i], states[i]);
+                else
+                    StateSerialization::writeXml(sources[i]->apvts, states[i]);
+            }
+
+            auto restoreStart = juce::Time::getHighResolutionTicks();
+
+            for (size_t i = 0; i < targets.size(); ++i)
+                targets[i]->setStateInformation(states[i].getData(), (int) states[i].getSize());
+
+            auto restoreEnd = juce::Time::getHighResolutionTicks();
+
+            //every parameter should come back as it was saved
+            int numMismatches = 0;
+
+            for (size_t i = 0; i < targets.size(); ++i)
+                for (int p = 0; p < sources[i]->getParameters().size(); ++p)
+                    if (std::abs(sources[i]->getParameters()[p]->getValue() - targets[i]->getParameters()[p]->getValue()) > 1.0e-4f)
+                        ++numMismatches;
+
+            auto* object = new juce::DynamicObject();
+            object->setProperty("format", format == StateSerialization::Format::binary ? "binary" : "xml");
+            object->setProperty("instances", numInstances);
+            object->setProperty("bytesPerState", (juce::int64) states.front().getSize());
+            object->setProperty("saveMs", juce::Time::highResolutionTicksToSeconds(restoreStart - saveStart) * 1.0e3);
+            object->setProperty("restoreMs", juce::Time::highResolutionTicksToSeconds(restoreEnd - restoreStart) * 1.0e3);
+            object->setProperty("mismatches", numMismatches);
+            results.append(juce::var(object));
+        }
+
+        return results;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    auto quick = args.containsOption("--quick");
+    auto seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 1.0;
+
+    //violations end up in the report, logging each one would only slow the cases down
+    RealtimeSafety::setLoggingEnabled(false);
+    juce::int64 numViolations = 0;
+
+    auto* report = new juce::DynamicObject();
+    juce::var reportVar(report);
+
+    report->setProperty("juceVersion", juce::SystemStats::getJUCEVersion());
+    report->setProperty("cpu", juce::SystemStats::getCpuModel());
+    report->setProperty("simdLanes", (int) SimdCascade::numLanes);
+    report->setProperty("secondsPerCase", seconds);
+
+    report->setProperty("processBlock", runCases(getProcessBlockCases(quick), seconds, "processBlock", numViolations));
+    report->setProperty("paths", runCases(getPathCases(), seconds, "paths", numViolations));
+
+    int numPathMismatches = 0;
+    report->setProperty("pathEquivalence", runPathEquivalenceCases(getPathEquivalenceCases(), numPathMismatches));
+    report->setProperty("smoothing", runCases(getSmoothingCases(), seconds, "smoothing", numViolations));
+    report->setProperty("oversampling", runCases(getOversamplingCases(), seconds, "oversampling", numViolations));
+    report->setProperty("linearPhase", runCases(getLinearPhaseCases(), seconds, "linearPhase", numViolations));
+    report->setProperty("analyzer", runCases(getAnalyzerCases(), seconds, "analyzer", numViolations));
+    report->setProperty("precision", runCases(getPrecisionCases(), seconds, "precision", numViolations));
+    report->setProperty("modulation", runCases(getModulationCases(), seconds, "modulation", numViolations));
+    report->setProperty("parametricBands", runCases(getParametricBandCases(), seconds, "parametricBands", numViolations));
+    report->setProperty("dynamic", runCases(getDynamicCases(), seconds, "dynamic", numViolations));
+    report->setProperty("idle", runCases(getIdleCases(), seconds, "idle", numViolations));
+    report->setProperty("loadMeter", runCases(getLoadMeterCases(), seconds, "loadMeter", numViolations));
+    report->setProperty("cutFilterDesign", runCutFilterDesignCases());
+    report->setProperty("cutFilters", runCutFilterCases(seconds));
+    report->setProperty("responseCurve", runResponseCurveCases());
+    report->setProperty("state", runStateCases());
+    report->setProperty("coefficientCache", runCoefficientCacheCases());
+    report->setProperty("precisionAccuracy", runAccuracyCases(getPrecisionCases()));
+    report->setProperty("filterEngineAccuracy", runAccuracyCases(getFilterEngineAccuracyCases()));
+    report->setProperty("processBlockViolations", numViolations);
+
+    auto json = juce::JSON::toString(reportVar);
+
+    if (args.containsOption("--output"))
+    {
+        auto outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output"));
+
+        if (! outputFile.replaceWithText(json))
+        {
+            std::cerr << "Can't write " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    //the paths are meant to be interchangeable, so a mismatch always fails the run
+    if (numPathMismatches > 0)
+    {
+        std::cerr << numPathMismatches << " path equivalence cases differ by more than " << pathTolerance << std::endl;
+        return 1;
+    }
+
+    if (args.containsOption("--fail-on-violations") && numViolations > 0)
+    {
+        std::cerr << numViolations << " real-time safety violations inside processBlock" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,306 @@
+/*
+  ==============================================================================
+
+    Offline render tool: streams audio files through SimpleEQAudioProcessor
+    without a host or a GUI.
+
+    SimpleEQRender --preset settings.json --output-dir out [--block-size 8192] [--threads N]
+                   [--telemetry telemetry.json] files...
+
+    The preset is a JSON object mapping parameter IDs to values in their
+    natural units, e.g. { "LowCut Freq": 80, "LowCut Slope": 2 }. Choice
+    parameters take the choice index.
+
+    Every file is read and written in blocks, so memory stays bounded however
+    long the file is. Files are spread across a thread pool with one
+    processor instance per file.
+
+    --telemetry writes each file's DspLoadMeter statistics as JSON, the load
+    of every stage of processBlock over the last blocks of the file.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    struct RenderSettings
+    {
+        juce::var preset;
+        juce::File outputDirectory;
+        int blockSize{ 8192 };
+    };
+
+    struct RenderResult
+    {
+        juce::String error;
+        double audioSeconds{ 0 }, renderSeconds{ 0 };
+        DspLoadMeter::Statistics loadStatistics;
+
+        double getRealTimeFactor() const { return renderSeconds > 0 ? audioSeconds / renderSeconds : 0; }
+    };
+
+    juce::Result applyPreset(SimpleEQAudioProcessor& processor, const juce::var& preset)
+    {
+        auto* object = preset.getDynamicObject();
+
+        if (object == nullptr)
+            return juce::Result::fail("The preset must be a JSON object of parameter IDs and values");
+
+        for (auto& property : object->getProperties())
+        {
+            auto* parameter = processor.apvts.getParameter(property.name.toString());
+
+            if (parameter == nullptr)
+                return juce::Result::fail("Unknown parameter: " + property.name.toString());
+
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(static_cast<float>(property.value)));
+        }
+
+        return juce::Result::ok();
+    }
+
+    RenderResult renderFile(const juce::File& inputFile, const RenderSettings& settings)
+    {
+        RenderResult result;
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(inputFile));
+
+        if (reader == nullptr)
+        {
+            result.error = "Can't read " + inputFile.getFullPathName();
+            return result;
+        }
+
+        auto outputFile = settings.outputDirectory.getChildFile(inputFile.getFileName());
+        auto* format = formatManager.findFormatForFileExtension(outputFile.getFileExtension());
+
+        if (format == nullptr || outputFile == inputFile)
+        {
+            result.error = "Can't write " + outputFile.getFullPathName();
+            return result;
+        }
+
+        outputFile.deleteFile();
+
+        auto numChannels = (int) reader->numChannels;
+        auto sampleRate = reader->sampleRate;
+
+        std::unique_ptr<juce::OutputStream> stream = std::make_unique<juce::FileOutputStream>(outputFile);
+        auto writer = format->createWriterFor(stream, juce::AudioFormatWriterOptions{}
+                                                          .withSampleRate(sampleRate)
+                                                          .withNumChannels(numChannels)
+                                                          .withBitsPerSample((int) reader->bitsPerSample));
+
+        if (writer == nullptr)
+        {
+            result.error = "Can't create a " + format->getFormatName() + " writer for " + outputFile.getFullPathName();
+            return result;
+        }
+
+        //one instance per file, laid out for the file's channel count
+        SimpleEQAudioProcessor processor;
+
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(juce::AudioChannelSet::canonicalChannelSet(numChannels));
+        layout.inputBuses.add(juce::AudioChannelSet::disabled());      //no sidechain, the dynamic peak listens to the file
+        layout.outputBuses.add(juce::AudioChannelSet::canonicalChannelSet(numChannels));
+
+        if (! processor.setBusesLayout(layout))
+        {
+            result.error = juce::String(numChannels) + " channel files aren't supported";
+            return result;
+        }
+
+        if (auto presetResult = applyPreset(processor, settings.preset); presetResult.failed())
+        {
+            result.error = presetResult.getErrorMessage();
+            return result;
+        }
+
+        processor.setNonRealtime(true);
+        processor.setRateAndBufferSizeDetails(sampleRate, settings.blockSize);
+        processor.prepareToPlay(sampleRate, settings.blockSize);
+
+        juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+        juce::MidiBuffer midi;
+
+        auto startTicks = juce::Time::getHighResolutionTicks();
+
+        //oversampling and linear phase delay the signal, so run on past the end and drop the start to line the output up
+        auto latency = (juce::int64) processor.getLatencySamples();
+        auto totalLength = reader->lengthInSamples + latency;
+
+        for (juce::int64 position = 0; position < totalLength; position += settings.blockSize)
+        {
+            auto numSamples = (int) juce::jmin((juce::int64) settings.blockSize, totalLength - position);
+
+            //the last block is shorter, so give processBlock a buffer of exactly that length
+            //reading past the end of the file gives silence
+            buffer.setSize(numChannels, numSamples, false, false, true);
+            reader->read(&buffer, 0, numSamples, position, true, true);
+
+            processor.processBlock(buffer, midi);
+
+            auto numToSkip = (int) juce::jlimit((juce::int64) 0, (juce::int64) numSamples, latency - position);
+
+            if (numToSkip < numSamples && ! writer->writeFromAudioSampleBuffer(buffer, numToSkip, numSamples - numToSkip))
+            {
+                result.error = "Write failed for " + outputFile.getFullPathName();
+                break;
+            }
+        }
+
+        result.renderSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+        result.audioSeconds = (double) reader->lengthInSamples / sampleRate;
+        result.loadStatistics = processor.getLoadMeter().getStatistics();
+
+        processor.releaseResources();
+        return result;
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: SimpleEQRender --preset settings.json --output-dir dir [--block-size 8192] [--threads N] "
+                     "[--telemetry telemetry.json] files..." << std::endl;
+    }
+
+    juce::Result writeTelemetry(const juce::File& file, const juce::Array<juce::File>& inputFiles, const std::vector<RenderResult>& results)
+    {
+        juce::var telemetry;
+
+        for (int i = 0; i < inputFiles.size(); ++i)
+        {
+            const auto& result = results[(size_t) i];
+
+            if (result.error.isNotEmpty())
+                continue;
+
+            auto* object = new juce::DynamicObject();
+            object->setProperty("file", inputFiles[i].getFileName());
+            object->setProperty("audioSeconds", result.audioSeconds);
+            object->setProperty("renderSeconds", result.renderSeconds);
+            object->setProperty("load", DspLoadMeter::toVar(result.loadStatistics));
+            telemetry.append(juce::var(object));
+        }
+
+        if (! file.replaceWithText(juce::JSON::toString(telemetry)))
+            return juce::Result::fail("Can't write " + file.getFullPathName());
+
+        return juce::Result::ok();
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    if (! args.containsOption("--preset") || ! args.containsOption("--output-dir"))
+    {
+        printUsage();
+        return 1;
+    }
+
+    RenderSettings settings;
+
+    auto presetFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--preset"));
+
+    if (auto parseResult = juce::JSON::parse(presetFile.loadFileAsString(), settings.preset); parseResult.failed())
+    {
+        std::cout << "Can't parse " << presetFile.getFullPathName() << ": " << parseResult.getErrorMessage() << std::endl;
+        return 1;
+    }
+
+    settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output-dir"));
+
+    if (auto directoryResult = settings.outputDirectory.createDirectory(); directoryResult.failed())
+    {
+        std::cout << directoryResult.getErrorMessage() << std::endl;
+        return 1;
+    }
+
+    if (args.containsOption("--block-size"))
+        settings.blockSize = juce::jlimit(16, 1 << 20, args.getValueForOption("--block-size").getIntValue());
+
+    auto numThreads = args.containsOption("--threads") ? args.getValueForOption("--threads").getIntValue()
+                                                       : juce::SystemStats::getNumCpus();
+
+    //everything that isn't an option or an option's value is an input file
+    juce::Array<juce::File> inputFiles;
+
+    for (int i = 0; i < args.size(); ++i)
+    {
+        auto& argument = args.arguments.getReference(i);
+
+        if (argument.isOption())
+        {
+            //"--option value" takes the next argument with it, "--option=value" doesn't
+            if (! argument.text.contains("="))
+                ++i;
+
+            continue;
+        }
+
+        inputFiles.add(juce::File::getCurrentWorkingDirectory().getChildFile(argument.text));
+    }
+
+    if (inputFiles.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<RenderResult> results((size_t) inputFiles.size());
+
+    {
+        juce::ThreadPool pool(juce::jmax(1, numThreads));
+
+        for (int i = 0; i < inputFiles.size(); ++i)
+            pool.addJob([&results, &inputFiles, &settings, i] { results[(size_t) i] = renderFile(inputFiles[i], settings); });
+
+        //the pool's destructor drops jobs that haven't started, so wait for all of them first
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+    }
+
+    int numFailed = 0;
+
+    for (int i = 0; i < inputFiles.size(); ++i)
+    {
+        const auto& result = results[(size_t) i];
+
+        if (result.error.isNotEmpty())
+        {
+            std::cout << inputFiles[i].getFileName() << ": " << result.error << std::endl;
+            ++numFailed;
+            continue;
+        }
+
+        std::cout << inputFiles[i].getFileName() << ": "
+                  << juce::String(result.audioSeconds, 2) << " s of audio in "
+                  << juce::String(result.renderSeconds, 3) << " s, "
+                  << juce::String(result.getRealTimeFactor(), 1) << "x real time" << std::endl;
+    }
+
+    if (args.containsOption("--telemetry"))
+    {
+        auto telemetryFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--telemetry"));
+
+        if (auto telemetryResult = writeTelemetry(telemetryFile, inputFiles, results); telemetryResult.failed())
+        {
+            std::cout << telemetryResult.getErrorMessage() << std::endl;
+            return 1;
+        }
+    }
+
+    return numFailed == 0 ? 0 : 1;
+}
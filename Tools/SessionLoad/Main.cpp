@@ -0,0 +1,550 @@
+/*
+  ==============================================================================
+
+    Session load test: runs hundreds of SimpleEQAudioProcessor instances the
+    way a DAW does, spread over a pool of worker threads, one block per
+    instance per audio callback, and checks every callback against its
+    deadline.
+
+    SimpleEQSessionLoad [--instances 500] [--threads N] [--block-size 256]
+                        [--sample-rate 48000] [--seconds 10] [--automation 0.05]
+                        [--idle 0.0] [--free-running] [--scaling]
+                        [--output results.json] [--fail-on-misses]
+
+    Each callback hands every worker a contiguous share of the instances.
+    A worker takes its own from the back and, once it runs out, steals from
+    the front of the others' shares, so a slow instance or a descheduled
+    thread doesn't hold the whole callback up.
+
+    The callbacks are paced in real time unless --free-running is given.
+    The deadline of each one is the end of its block period, and every
+    processBlock that finishes after it counts as a missed block.
+    --automation is the chance per block that an instance gets a random
+    parameter change from the worker running it, as host automation would,
+    and --idle the share of instances fed silence.
+
+    The report gives the deadline misses, the callback time against the
+    period, the allocations and locks made inside processBlock (counted by
+    RealtimeSafety, so this target is built with SIMPLEEQ_RT_SAFETY_CHECKS=1)
+    and the resident memory per instance. --scaling adds a free running
+    pass for every thread count from 1 to --threads in powers of two, with
+    the throughput and speedup of each, which is where false sharing and
+    allocator contention show up.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include <numeric>
+#include "../../Source/PluginProcessor.h"
+
+#if JUCE_LINUX
+ #include <unistd.h>
+#endif
+
+//==============================================================================
+#if ! SIMPLEEQ_RT_SAFETY_CHECKS
+ #error "The load test counts allocations through RealtimeSafety, build it with SIMPLEEQ_RT_SAFETY_CHECKS=1"
+#endif
+
+namespace
+{
+    using ViolationType = RealtimeSafety::ViolationType;
+
+    struct SessionSettings
+    {
+        int numInstances{ 500 };
+        int numThreads{ 1 };
+        int blockSize{ 256 };
+        double sampleRate{ 48000 };
+        double seconds{ 10 };
+        double automationRate{ 0.05 };
+        double idleFraction{ 0 };
+        bool isRealtime{ true };
+    };
+
+    //resident memory of the process, 0 where it can't be read
+    size_t getResidentBytes()
+    {
+       #if JUCE_LINUX
+        auto fields = juce::StringArray::fromTokens(juce::File("/proc/self/statm").loadFileAsString(), false);
+
+        if (fields.size() > 1)
+            return (size_t) fields[1].getLargeIntValue() * (size_t) sysconf(_SC_PAGESIZE);
+       #endif
+
+        return 0;
+    }
+
+    //one track of the session: an instance with its own buffer, like a host gives each plugin
+    class Instance
+    {
+    public:
+        Instance(const SessionSettings& settings, int index)
+            : random(index + 1)
+        {
+            juce::AudioProcessor::BusesLayout layout;
+            layout.inputBuses.add(juce::AudioChannelSet::stereo());
+            layout.inputBuses.add(juce::AudioChannelSet::disabled());
+            layout.outputBuses.add(juce::AudioChannelSet::stereo());
+            processor.setBusesLayout(layout);
+
+            //the continuous parameters a host would be automating
+            for (auto* parameterID : { "LowCut Freq", "HighCut Freq", "Peak Freq", "Peak Gain", "Peak Quality" })
+                if (auto* parameter = processor.apvts.getParameter(parameterID))
+                    automatedParameters.push_back(parameter);
+
+            //every track starts somewhere different
+            for (auto* parameter : automatedParameters)
+                parameter->setValueNotifyingHost(random.nextFloat());
+
+            //spread evenly through the session rather than all at the start
+            isSilent = settings.idleFraction > 0 && std::fmod(index * settings.idleFraction, 1.0) + settings.idleFraction >= 1.0;
+
+            buffer.setSize(2, settings.blockSize);
+
+            processor.setRateAndBufferSizeDetails(settings.sampleRate, settings.blockSize);
+            processor.prepareToPlay(settings.sampleRate, settings.blockSize);
+        }
+
+        ~Instance()
+        {
+            processor.releaseResources();
+        }
+
+        //worker thread: what the host does for one plugin in a callback
+        void process(const juce::AudioBuffer<float>& source, double automationRate)
+        {
+            if (isSilent)
+                buffer.clear();
+            else
+                buffer.makeCopyOf(source, true);
+
+            if (! automatedParameters.empty() && random.nextDouble() < automationRate)
+                automatedParameters[(size_t) random.nextInt((int) automatedParameters.size())]->setValueNotifyingHost(random.nextFloat());
+
+            processor.processBlock(buffer, midi);
+        }
+
+    private:
+        SimpleEQAudioProcessor processor;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+
+        std::vector<juce::RangedAudioParameter*> automatedParameters;
+        juce::Random random;
+        bool isSilent{ false };
+
+        JUCE_DECLARE_NON_COPYABLE(Instance)
+    };
+
+    //==============================================================================
+    class WorkStealingPool
+    {
+    public:
+        WorkStealingPool(std::vector<std::unique_ptr<Instance>>& instancesToRun, const juce::AudioBuffer<float>& sourceBuffer,
+                         int numThreads, double automationRate)
+            : instances(instancesToRun), source(sourceBuffer), automation(automationRate)
+        {
+            for (int i = 0; i < numThreads; ++i)
+                workers.push_back(std::make_unique<Worker>(*this, (size_t) i));
+
+            for (auto& worker : workers)
+                worker->startThread();
+        }
+
+        ~WorkStealingPool()
+        {
+            for (auto& worker : workers)
+            {
+                worker->signalThreadShouldExit();
+                worker->start.signal();
+            }
+
+            for (auto& worker : workers)
+                worker->stopThread(10000);
+        }
+
+        //runs a block of every instance and returns once they're all done
+        void runCallback(juce::int64 deadlineTicks)
+        {
+            deadline = deadlineTicks;
+
+            //contiguous shares, so an instance tends to stay on the same core from one callback to the next
+            auto numInstances = instances.size();
+            auto numWorkers = workers.size();
+
+            for (size_t i = 0; i < numWorkers; ++i)
+                workers[i]->share.set(i * numInstances / numWorkers, (i + 1) * numInstances / numWorkers);
+
+            numWorking = (int) numWorkers;
+
+            for (auto& worker : workers)
+                worker->start.signal();
+
+            done.wait(-1);
+        }
+
+        struct Totals
+        {
+            juce::int64 blocks{ 0 }, missedBlocks{ 0 }, steals{ 0 }, allocations{ 0 }, mutexLocks{ 0 };
+        };
+
+        Totals getTotals() const
+        {
+            Totals totals;
+
+            for (auto& worker : workers)
+            {
+                totals.blocks += worker->stats.blocks;
+                totals.missedBlocks += worker->stats.missedBlocks;
+                totals.steals += worker->stats.steals;
+                totals.allocations += worker->stats.allocations;
+                totals.mutexLocks += worker->stats.mutexLocks;
+            }
+
+            return totals;
+        }
+
+    private:
+        //a worker's share of the instances, [head, tail) packed into one word so taking from either end is one CAS
+        struct alignas(64) Share
+        {
+            std::atomic<juce::uint64> range{ 0 };
+
+            void set(size_t head, size_t tail) noexcept { range.store(pack(head, tail), std::memory_order_relaxed); }
+
+            //the owner works from the back
+            int takeBack() noexcept
+            {
+                auto current = range.load(std::memory_order_relaxed);
+
+                for (;;)
+                {
+                    auto head = current & 0xffffffff, tail = current >> 32;
+
+                    if (head >= tail)
+                        return -1;
+
+                    if (range.compare_exchange_weak(current, pack(head, tail - 1), std::memory_order_acquire))
+                        return (int) tail - 1;
+                }
+            }
+
+            //thieves from the front, so they only meet the owner over the last instance
+            int takeFront() noexcept
+            {
+                auto current = range.load(std::memory_order_relaxed);
+
+                for (;;)
+                {
+                    auto head = current & 0xffffffff, tail = current >> 32;
+
+                    if (head >= tail)
+                        return -1;
+
+                    if (range.compare_exchange_weak(current, pack(head + 1, tail), std::memory_order_acquire))
+                        return (int) head;
+                }
+            }
+
+            static juce::uint64 pack(juce::uint64 head, juce::uint64 tail) noexcept { return head | (tail << 32); }
+        };
+
+        //only ever written by the worker they belong to, read once the run is over
+        struct alignas(64) WorkerStats
+        {
+            juce::int64 blocks{ 0 }, missedBlocks{ 0 }, steals{ 0 }, allocations{ 0 }, mutexLocks{ 0 };
+        };
+
+        struct Worker : public juce::Thread
+        {
+            Worker(WorkStealingPool& owner, size_t workerIndex)
+                : juce::Thread("SessionLoad Worker " + juce::String((int) workerIndex)), pool(owner), index(workerIndex)
+            {
+            }
+
+            void run() override
+            {
+                for (;;)
+                {
+                    start.wait(-1);
+
+                    if (threadShouldExit())
+                        return;
+
+                    pool.work(*this);
+                }
+            }
+
+            WorkStealingPool& pool;
+            size_t index;
+            juce::WaitableEvent start;
+            Share share;
+            WorkerStats stats;
+        };
+
+        void work(Worker& worker)
+        {
+            for (;;)
+            {
+                auto instance = worker.share.takeBack();
+
+                //look round the other workers, starting with the next one so the thieves spread out
+                for (size_t i = 1; instance < 0 && i < workers.size(); ++i)
+                    if ((instance = workers[(worker.index + i) % workers.size()]->share.takeFront()) >= 0)
+                        ++worker.stats.steals;
+
+                if (instance < 0)
+                    break;
+
+                auto allocationsBefore = RealtimeSafety::getThreadViolationCount(ViolationType::allocation);
+                auto mutexLocksBefore = RealtimeSafety::getThreadViolationCount(ViolationType::mutexLock);
+
+                instances[(size_t) instance]->process(source, automation);
+
+                worker.stats.allocations += RealtimeSafety::getThreadViolationCount(ViolationType::allocation) - allocationsBefore;
+                worker.stats.mutexLocks += RealtimeSafety::getThreadViolationCount(ViolationType::mutexLock) - mutexLocksBefore;
+                ++worker.stats.blocks;
+
+                if (juce::Time::getHighResolutionTicks() > deadline)
+                    ++worker.stats.missedBlocks;
+            }
+
+            //every share is empty and this worker's last block is finished
+            if (numWorking.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                done.signal();
+        }
+
+        std::vector<std::unique_ptr<Instance>>& instances;
+        const juce::AudioBuffer<float>& source;
+        double automation;
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        juce::int64 deadline{ 0 };
+        std::atomic<int> numWorking{ 0 };
+        juce::WaitableEvent done;
+    };
+
+    //==============================================================================
+    struct RunResult
+    {
+        int numThreads{ 0 };
+        int numCallbacks{ 0 }, missedCallbacks{ 0 };
+        WorkStealingPool::Totals totals;
+        double wallSeconds{ 0 };
+        double p50{ 0 }, p99{ 0 }, max{ 0 };        //callback time as a share of the block period
+
+        double getBlocksPerSecond() const { return wallSeconds > 0 ? (double) totals.blocks / wallSeconds : 0; }
+    };
+
+    double getPercentile(const std::vector<double>& sortedValues, double percentile)
+    {
+        auto index = (size_t) juce::jlimit(0.0, (double) sortedValues.size() - 1, std::ceil(percentile * (double) sortedValues.size()) - 1);
+        return sortedValues[index];
+    }
+
+    RunResult runSession(std::vector<std::unique_ptr<Instance>>& instances, const juce::AudioBuffer<float>& source,
+                         const SessionSettings& settings, int numThreads, bool isRealtime)
+    {
+        RunResult result;
+        result.numThreads = numThreads;
+        result.numCallbacks = juce::jmax(1, (int) (settings.seconds * settings.sampleRate / settings.blockSize));
+
+        WorkStealingPool pool(instances, source, numThreads, settings.automationRate);
+
+        auto periodTicks = (juce::int64) ((double) juce::Time::getHighResolutionTicksPerSecond() * settings.blockSize / settings.sampleRate);
+        std::vector<double> callbackLoads;
+        callbackLoads.reserve((size_t) result.numCallbacks);
+
+        auto sessionStart = juce::Time::getHighResolutionTicks();
+
+        for (int callback = 0; callback < result.numCallbacks; ++callback)
+        {
+            auto now = juce::Time::getHighResolutionTicks();
+
+            //a host calls back once per period, a callback that ran over starts the next one late
+            auto callbackStart = isRealtime ? juce::jmax(now, sessionStart + callback * periodTicks) : now;
+
+            while ((now = juce::Time::getHighResolutionTicks()) < callbackStart)
+            {
+                if (juce::Time::highResolutionTicksToSeconds(callbackStart - now) > 0.002)
+                    juce::Thread::sleep(1);
+                else
+                    juce::Thread::yield();
+            }
+
+            pool.runCallback(callbackStart + periodTicks);
+
+            auto callbackTicks = juce::Time::getHighResolutionTicks() - callbackStart;
+            callbackLoads.push_back((double) callbackTicks / (double) periodTicks);
+
+            if (callbackTicks > periodTicks)
+                ++result.missedCallbacks;
+        }
+
+        result.wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - sessionStart);
+        result.totals = pool.getTotals();
+
+        std::sort(callbackLoads.begin(), callbackLoads.end());
+        result.p50 = getPercentile(callbackLoads, 0.5);
+        result.p99 = getPercentile(callbackLoads, 0.99);
+        result.max = callbackLoads.back();
+
+        return result;
+    }
+
+    juce::var toVar(const RunResult& result, double singleThreadBlocksPerSecond)
+    {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("threads", result.numThreads);
+        object->setProperty("callbacks", result.numCallbacks);
+        object->setProperty("missedCallbacks", result.missedCallbacks);
+        object->setProperty("blocks", result.totals.blocks);
+        object->setProperty("missedBlocks", result.totals.missedBlocks);
+        object->setProperty("steals", result.totals.steals);
+        object->setProperty("allocations", result.totals.allocations);
+        object->setProperty("mutexLocks", result.totals.mutexLocks);
+        object->setProperty("callbackLoadP50", result.p50);
+        object->setProperty("callbackLoadP99", result.p99);
+        object->setProperty("callbackLoadMax", result.max);
+        object->setProperty("blocksPerSecond", result.getBlocksPerSecond());
+
+        if (singleThreadBlocksPerSecond > 0)
+        {
+            auto speedup = result.getBlocksPerSecond() / singleThreadBlocksPerSecond;
+            object->setProperty("speedup", speedup);
+            object->setProperty("efficiency", speedup / result.numThreads);
+        }
+
+        return juce::var(object);
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: SimpleEQSessionLoad [--instances 500] [--threads N] [--block-size 256] [--sample-rate 48000] "
+                     "[--seconds 10] [--automation 0.05] [--idle 0.0] [--free-running] [--scaling] "
+                     "[--output results.json] [--fail-on-misses]" << std::endl;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    auto getOption = [&args](const juce::String& option, double defaultValue)
+    {
+        return args.containsOption(option) ? args.getValueForOption(option).getDoubleValue() : defaultValue;
+    };
+
+    SessionSettings settings;
+    settings.numInstances = juce::jlimit(1, 100000, (int) getOption("--instances", settings.numInstances));
+    settings.numThreads = juce::jlimit(1, 256, (int) getOption("--threads", juce::SystemStats::getNumCpus()));
+    settings.blockSize = juce::jlimit(16, 8192, (int) getOption("--block-size", settings.blockSize));
+    settings.sampleRate = juce::jlimit(8000.0, 768000.0, getOption("--sample-rate", settings.sampleRate));
+    settings.seconds = juce::jmax(0.1, getOption("--seconds", settings.seconds));
+    settings.automationRate = juce::jlimit(0.0, 1.0, getOption("--automation", settings.automationRate));
+    settings.idleFraction = juce::jlimit(0.0, 1.0, getOption("--idle", settings.idleFraction));
+    settings.isRealtime = ! args.containsOption("--free-running");
+
+    //violations end up in the report, logging each one would only slow the session down
+    RealtimeSafety::setLoggingEnabled(false);
+
+    //the same noise for every playing track, copied in before each block so it never decays into denormals
+    juce::AudioBuffer<float> source(2, settings.blockSize);
+    juce::Random random(1234);
+
+    for (int ch = 0; ch < source.getNumChannels(); ++ch)
+        for (int i = 0; i < source.getNumSamples(); ++i)
+            source.setSample(ch, i, random.nextFloat() * 2.f - 1.f);
+
+    //what the instances cost in memory, prepared and ready to play
+    auto residentBefore = getResidentBytes();
+    std::vector<std::unique_ptr<Instance>> instances;
+
+    for (int i = 0; i < settings.numInstances; ++i)
+    {
+        std::cerr << "creating instances " << (i + 1) << "/" << settings.numInstances << "\r" << std::flush;
+        instances.push_back(std::make_unique<Instance>(settings, i));
+    }
+
+    std::cerr << std::endl;
+    auto residentAfter = getResidentBytes();
+
+    auto* report = new juce::DynamicObject();
+    juce::var reportVar(report);
+
+    report->setProperty("juceVersion", juce::SystemStats::getJUCEVersion());
+    report->setProperty("cpu", juce::SystemStats::getCpuModel());
+    report->setProperty("cores", juce::SystemStats::getNumCpus());
+    report->setProperty("instances", settings.numInstances);
+    report->setProperty("blockSize", settings.blockSize);
+    report->setProperty("sampleRate", settings.sampleRate);
+    report->setProperty("automation", settings.automationRate);
+    report->setProperty("idle", settings.idleFraction);
+    report->setProperty("processorObjectBytes", (juce::int64) sizeof(SimpleEQAudioProcessor));
+
+    if (residentAfter > residentBefore)
+        report->setProperty("residentBytesPerInstance", (juce::int64) ((residentAfter - residentBefore) / (size_t) settings.numInstances));
+
+    std::cerr << "session, " << settings.numThreads << " threads" << std::endl;
+    auto session = runSession(instances, source, settings, settings.numThreads, settings.isRealtime);
+
+    report->setProperty("realtime", settings.isRealtime);
+    report->setProperty("session", toVar(session, 0));
+
+    if (args.containsOption("--scaling"))
+    {
+        juce::var scaling;
+        double singleThreadBlocksPerSecond = 0;
+
+        for (int numThreads = 1; numThreads <= settings.numThreads; numThreads *= 2)
+        {
+            std::cerr << "scaling, " << numThreads << " threads" << std::endl;
+
+            auto result = runSession(instances, source, settings, numThreads, false);
+
+            if (numThreads == 1)
+                singleThreadBlocksPerSecond = result.getBlocksPerSecond();
+
+            scaling.append(toVar(result, singleThreadBlocksPerSecond));
+        }
+
+        report->setProperty("scaling", scaling);
+    }
+
+    auto json = juce::JSON::toString(reportVar);
+
+    if (args.containsOption("--output"))
+    {
+        auto outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output"));
+
+        if (! outputFile.replaceWithText(json))
+        {
+            std::cerr << "Can't write " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    if (args.containsOption("--fail-on-misses") && session.totals.missedBlocks > 0)
+    {
+        std::cerr << session.totals.missedBlocks << " blocks missed their deadline" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}